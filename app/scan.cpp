@@ -1,46 +1,39 @@
-#include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <vector>
+#include <thread>
 
 #include "camera/api/lucid.h"
 
 int main() {
-    std::vector<camera::DeviceInfo> checked;
+    const auto system = camera::openSystem<camera::lucid::System>();
 
-    const auto contains = [&](const camera::DeviceInfo& item) {
-        return std::any_of(checked.begin(), checked.end(), [&](const auto& i) { return i.serial == item.serial; });
+    camera::lucid::Discovery::Callbacks callbacks;
+    callbacks.arrival = [](const camera::DeviceInfo& item) {
+        // clang-format off
+        std::clog
+        << item.mac << " [S/N: " << item.serial << "]"
+        << "\033[90m"
+        << "\n- IP            : " << item.ipv4
+        << "\n- Subnet Mask   : " << item.subnet_mask
+        << "\n- Gateway       : " << item.gateway
+        << "\n- Interface     : " << item.host_ipv4
+        << "\n- DHCP Enabled  : " << item.dhcp_enabled
+        << "\n- Persistent IP : " << item.persistent_ip_enabled
+        << "\n- LLA Enabled   : " << item.lla_enabled
+        << "\033[0m"
+        << std::endl;
+        // clang-format on
+    };
+    callbacks.departure = [](const camera::DeviceInfo& item) {
+        std::clog << item.mac << " [S/N: " << item.serial << "] departed" << std::endl;
+    };
+    callbacks.address_change = [](const camera::DeviceInfo& previous, const camera::DeviceInfo& current) {
+        std::clog << current.mac << " [S/N: " << current.serial << "] " << previous.ipv4 << " -> " << current.ipv4
+                  << std::endl;
     };
 
-    const auto system = camera::openSystem<camera::lucid::System>();
-    const auto start  = std::chrono::steady_clock::now();
-
-    while (std::chrono::steady_clock::now() - start < std::chrono::seconds{10}) {
-        try {
-            const auto scanned = system->scan();
-            for (const auto& item : scanned) {
-                if (contains(item)) {
-                    continue;
-                }
-                // clang-format off
-                std::clog
-                << item.mac << " [S/N: " << item.serial << "]"
-                << "\033[90m"
-                << "\n- IP            : " << item.ipv4
-                << "\n- Subnet Mask   : " << item.subnet_mask
-                << "\n- Gateway       : " << item.gateway
-                << "\n- DHCP Enabled  : " << item.dhcp_enabled
-                << "\n- Persistent IP : " << item.persistent_ip_enabled
-                << "\n- LLA Enabled   : " << item.lla_enabled
-                << "\033[0m"
-                << std::endl;
-                // clang-format on
-                checked.emplace_back(item);
-            }
-        } catch (const std::exception& e) {
-            // nothing to do
-        }
-    }
+    camera::lucid::Discovery discovery(*system, camera::lucid::Discovery::Options{}, callbacks);
+    std::this_thread::sleep_for(std::chrono::seconds{10});
 
     return 0;
 }
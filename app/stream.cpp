@@ -53,46 +53,52 @@ int main() {
         const auto device = devices[i];
 
         camera::DeviceParameters params;
-        params.action_unconditional_mode         = "On";
+        params.action_unconditional_mode         = camera::Switch::ON;
         params.acquisition_frame_rate            = 30.0;
-        params.acquisition_mode                  = "Continuous";
-        params.acquisition_start_mode            = "LowLatency";
+        params.acquisition_mode                  = camera::AcquisitionMode::CONTINUOUS;
+        params.acquisition_start_mode            = camera::AcquisitionStartMode::LOW_LATENCY;
         params.binning_horizontal                = 1;
-        params.binning_horizontal_mode           = "Average";
-        params.binning_selector                  = "Digital";
+        params.binning_horizontal_mode           = camera::BinningMode::AVERAGE;
+        params.binning_selector                  = camera::BinningSelector::DIGITAL;
         params.binning_vertical                  = 1;
-        params.binning_vertical_mode             = "Average";
-        params.exposure_auto                     = "Continuous";
-        params.exposure_auto_limit_auto          = "Off";
+        params.binning_vertical_mode             = camera::BinningMode::AVERAGE;
+        params.exposure_auto                     = camera::AutoMode::CONTINUOUS;
+        params.exposure_auto_limit_auto          = camera::AutoMode::OFF;
         params.exposure_auto_lower_limit         = 30.0;
         params.exposure_auto_upper_limit         = 2500.0;
         params.exposure_time                     = 500.0;
         params.gev_current_ip_configuration_dhcp = scanned[i].persistent_ip_enabled ? false : true;
         params.persistent_ip_enable              = scanned[i].persistent_ip_enabled ? true : false;
-        params.gain_auto                         = "Continuous";
+        params.gain_auto                         = camera::AutoMode::CONTINUOUS;
         params.pixel_format                      = "BayerRG8";
         params.ptp_enable                        = true;
         params.ptp_slave_only                    = true;
         params.reverse_x                         = false;
         params.reverse_y                         = false;
         params.stream_auto_negotiate_packet_size = false;
-        params.stream_buffer_handling_mode       = "OldestFirstOverwrite";
+        params.stream_buffer_handling_mode       = camera::StreamBufferHandlingMode::OLDEST_FIRST_OVERWRITE;
         params.stream_multicast_enable           = false;
         params.stream_packet_resend_enable       = true;
         params.target_brightness                 = 90;
-        params.transfer_control_mode             = "UserControlled";
-        params.transfer_operation_mode           = "Continuous";
-        params.trigger_activation                = "RisingEdge";
-        params.trigger_latency                   = "Off";
-        params.trigger_mode                      = "Off";
-        params.trigger_overlap                   = "Off";
-        params.trigger_selector                  = "FrameStart";
+        params.transfer_control_mode             = camera::TransferControlMode::USER_CONTROLLED;
+        params.transfer_operation_mode           = camera::TransferOperationMode::CONTINUOUS;
+        params.trigger_activation                = camera::TriggerActivation::RISING_EDGE;
+        params.trigger_latency                   = camera::TriggerLatency::OFF;
+        params.trigger_mode                      = camera::Switch::OFF;
+        params.trigger_overlap                   = camera::TriggerOverlap::OFF;
+        params.trigger_selector                  = camera::TriggerSelector::FRAME_START;
         params.trigger_source                    = "Action0";
 
         device->config(params);
-        device->open();
     }
 
+    // devices of different host interfaces do not share a link, so each interface is brought up on its own thread
+    camera::lucid::System::forEachInterface(devices, [](const auto&, const auto& group) {
+        for (const auto& device : group) {
+            device->open();
+        }
+    });
+
     for (const auto device : devices) {
         device->stream();
     }
@@ -126,6 +132,20 @@ int main() {
     }
 
     for (const auto& device : devices) {
+        const auto stats = device->stats();
+        // clang-format off
+        std::clog
+            << device->info().serial
+            << "\033[90m"
+            << "\n- Frames          : " << stats.frames << " (" << stats.incomplete << " incomplete)"
+            << "\n- Lost Frames     : " << stats.lost_frames
+            << "\n- Missed Packets  : " << stats.missed_packets
+            << "\n- Resend Requests : " << stats.resend_requests
+            << "\n- Underruns       : " << stats.underruns
+            << "\033[0m"
+            << std::endl;
+        // clang-format on
+
         device->stop();
         device->release();
     }
@@ -0,0 +1,42 @@
+find_path(
+  TURBOJPEG_INCLUDE_DIR
+    NAMES "turbojpeg.h"
+    PATHS "/opt/libjpeg-turbo"
+    PATH_SUFFIXES "include"
+)
+find_library(
+  TURBOJPEG_LIBRARY
+    NAMES "turbojpeg"
+    PATHS "/opt/libjpeg-turbo"
+    PATH_SUFFIXES "lib64" "lib"
+)
+if(TURBOJPEG_INCLUDE_DIR AND TURBOJPEG_LIBRARY)
+  message(STATUS "[FindTurboJPEG.cmake] Found components for TurboJPEG")
+  message(STATUS "[FindTurboJPEG.cmake] ${TURBOJPEG_INCLUDE_DIR}")
+  message(STATUS "[FindTurboJPEG.cmake] ${TURBOJPEG_LIBRARY}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+  TurboJPEG DEFAULT_MSG
+    "TURBOJPEG_INCLUDE_DIR"
+    "TURBOJPEG_LIBRARY"
+)
+
+if(TurboJPEG_FOUND AND NOT TARGET TurboJPEG::TurboJPEG)
+  add_library(
+    TurboJPEG::TurboJPEG
+    UNKNOWN IMPORTED
+  )
+  set_target_properties(
+    TurboJPEG::TurboJPEG
+    PROPERTIES
+      INTERFACE_INCLUDE_DIRECTORIES "${TURBOJPEG_INCLUDE_DIR}"
+      IMPORTED_LOCATION "${TURBOJPEG_LIBRARY}"
+  )
+endif()
+
+mark_as_advanced(
+  TURBOJPEG_INCLUDE_DIR
+  TURBOJPEG_LIBRARY
+)
@@ -3,13 +3,28 @@
 #include <ArenaApi.h>
 #include <GenApi/GenApi.h>
 
+#include <camera/assembler.h>
+#include <camera/blackbox.h>
 #include <camera/device.h>
+#include <camera/enums.h>
+#include <camera/gap.h>
 #include <camera/image.h>
+#include <camera/latency.h>
+#include <camera/pool.h>
+#include <camera/profile.h>
+#include <camera/pyramid.h>
+#include <camera/queue.h>
+#include <camera/server.h>
+#include <camera/stats.h>
 #include <camera/system.h>
 
 #include <camera/lucid/config.hpp>
 #include <camera/lucid/device.hpp>
+#include <camera/lucid/discovery.hpp>
+#include <camera/lucid/ptp.hpp>
+#include <camera/lucid/scheduler.hpp>
 #include <camera/lucid/system.hpp>
+#include <camera/lucid/trigger.hpp>
 
 #include <camera/lucid/spec.h>
 #include <camera/lucid/types.h>
@@ -18,3 +33,7 @@
 
 #include <camera/exception.h>
 #include <camera/factory.h>
+
+#if defined(CAMERA_WITH_TURBOJPEG)
+    #include <camera/encoder.h>
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "camera/image.h"
+#include "camera/queue.h"
+
+namespace camera {
+
+/**
+ * @brief Groups the frames of several devices into synchronized sets.
+ *      Every device pushes its frames from its own capture thread into a private lock-free queue, so a slow device
+ *      never blocks the others. A single worker matches the frames and delivers each set once every device has
+ *      contributed, or as a partial set once its deadline has passed.
+ *
+ * @details
+ * frames are matched either by the spread of their stamps staying within a tolerance (`Mode::TIMESTAMP`), or by the
+ * action command they were triggered by (`Mode::ACTION_EPOCH`), which is derived from the stamp, the time of the first
+ * action command and the interval between action commands.
+ * sets are delivered in the order of their stamps. since every device delivers its frames in order, a complete set
+ * also closes every older set, which is then delivered right away as a partial set.
+ */
+class FrameSetAssembler {
+   public:
+    enum class Mode
+    {
+        TIMESTAMP,
+        ACTION_EPOCH,
+    };
+
+    struct Options {
+        std::size_t          num_devices     = 0;
+        Mode                 mode            = Mode::TIMESTAMP;
+        uint64_t             tolerance_ns    = 1'000'000;   // `Mode::TIMESTAMP`, widest spread of stamps in a set
+        uint64_t             epoch_origin_ns = 0;           // `Mode::ACTION_EPOCH`, stamp of the first action command
+        uint64_t             epoch_period_ns = 0;           // `Mode::ACTION_EPOCH`, interval between action commands
+        std::vector<int64_t> offsets_ns;                    // per device, subtracted from stamps before matching
+        uint64_t             deadline_ns    = 100'000'000;  // host time a set waits for missing frames
+        std::size_t          queue_capacity = 16;           // per device, frames not yet matched
+    };
+
+    struct FrameSet {
+        uint64_t                                   key = 0;  // earliest stamp of its frames, or index of the action
+        std::vector<std::shared_ptr<const IImage>> frames;   // indexed by device, null for missing frames
+        std::size_t                                count = 0;
+
+        [[nodiscard]] bool complete() const { return count == frames.size(); }
+    };
+
+    struct Stats {
+        uint64_t complete = 0;  // sets delivered with every frame
+        uint64_t partial  = 0;  // sets delivered with missing frames
+        uint64_t dropped  = 0;  // frames rejected because the queue of their device was full
+        uint64_t late     = 0;  // frames discarded because their set had already been delivered
+    };
+
+    using Callback = std::function<void(FrameSet&& set)>;
+
+    /**
+     * @param options [in]
+     * @param callback [in] Invoked with every set in order, from the worker thread.
+     * @throw camera::exception::InvalidConfigValue if the options are inconsistent.
+     */
+    FrameSetAssembler(const Options& options, Callback callback);
+    ~FrameSetAssembler();
+
+    FrameSetAssembler(const FrameSetAssembler&)            = delete;
+    FrameSetAssembler& operator=(const FrameSetAssembler&) = delete;
+
+    /**
+     * @brief Hands over a frame of a device. It never blocks the caller.
+     *      Each device must push from a single thread at a time.
+     * @param device [in] Index of the device, in [0, `Options::num_devices`).
+     * @param image [in]
+     * @return false if the queue of the device is full, in which case the frame is dropped.
+     */
+    bool push(const std::size_t device, std::shared_ptr<const IImage> image);
+
+    /**
+     * @brief Gets the counters accumulated since construction.
+     * @return Stats
+     */
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    struct Pending {
+        FrameSet set;
+        uint64_t max_key   = 0;  // latest key of its frames, `set.key` being the earliest
+        uint64_t opened_ns = 0;
+    };
+
+    uint64_t keyOf_(const std::size_t device, const IImage& image) const;
+    void     match_(const std::size_t device, std::shared_ptr<const IImage> image);
+    void     expire_(const uint64_t now);
+    void     deliver_(const std::size_t count);
+    void     run_();
+
+    Options  options_;
+    Callback callback_;
+
+    std::vector<std::unique_ptr<SpscQueue<std::shared_ptr<const IImage>>>> queues_;
+
+    std::deque<Pending> pending_;  // open sets in order of their keys, touched by the worker only
+    bool                has_delivered_ = false;
+    uint64_t            last_key_      = 0;
+
+    std::atomic<uint64_t> complete_{0};
+    std::atomic<uint64_t> partial_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> late_{0};
+
+    std::mutex              wakeup_mutex_;
+    std::condition_variable wakeup_cv_;
+    std::atomic<uint64_t>   queued_{0};
+    std::atomic<bool>       stop_requested_{false};
+    std::thread             worker_;
+};
+
+}  // namespace camera
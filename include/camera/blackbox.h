@@ -0,0 +1,131 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Pre-trigger recorder which retains the most recent frames of a device in memory.
+ *      Frames are kept by reference, so retaining them costs no copy; their buffers go back to the capture pool
+ *      once they fall out of the ring. `BlackBox::flush()` persists a time window around an event to disk on a
+ *      background thread while the ring keeps on recording.
+ *
+ * @details
+ * every flushed window is written to a single file, which consists of consecutive records of
+ * `BlackBox::Record` followed by `Record::size` bytes of raw image data.
+ *
+ * @note
+ * `BlackBox::push()` is meant to be called from the capture thread of a single device.
+ */
+class BlackBox {
+   public:
+    /**
+     * @brief Bounds of the ring. Frames are evicted as soon as either limit is exceeded.
+     *      A limit of 0 is ignored.
+     */
+    struct Capacity {
+        uint64_t    duration_ns = 5'000'000'000;  // span between the oldest and the newest frame stamp
+        std::size_t bytes       = 0;              // total size of the retained image data
+    };
+
+    /**
+     * @brief Time window around an event, in device stamp nanoseconds.
+     */
+    struct Window {
+        uint64_t event_stamp = 0;
+        uint64_t before_ns   = 0;
+        uint64_t after_ns    = 0;
+    };
+
+    /**
+     * @brief On-disk header of each frame in a flushed file.
+     */
+    struct Record {
+        uint64_t stamp;
+        uint64_t seq;
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t step;
+        uint64_t depth;
+        uint64_t size;
+        uint64_t complete;
+    };
+
+    /**
+     * @param capacity [in] Bounds of the ring.
+     * @param directory [in] Directory to write flushed windows into. Created if it does not exist.
+     * @param prefix [in] Prefix of the flushed file names, e.g. serial number of the device.
+     */
+    BlackBox(const Capacity& capacity, const std::filesystem::path& directory, const std::string& prefix = "");
+    ~BlackBox();
+
+    BlackBox(const BlackBox&)            = delete;
+    BlackBox& operator=(const BlackBox&) = delete;
+
+    /**
+     * @brief Appends a captured frame to the ring and evicts the frames beyond the capacity.
+     * @param image [in]
+     */
+    void push(const std::shared_ptr<const IImage>& image);
+
+    /**
+     * @brief Requests the frames within the window to be written to disk.
+     *      Frames before the event are taken from the ring immediately; frames after the event are collected as they
+     *      are pushed, and the file is written once the window is complete.
+     * @param window [in]
+     * @return Path of the written file, available once writing has finished.
+     */
+    [[nodiscard]] std::future<std::filesystem::path> flush(const Window& window);
+
+    /**
+     * @brief Gets the number of frames currently retained.
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Gets the size of the image data currently retained.
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t bytes() const;
+
+   private:
+    struct Job {
+        Window                                     window;
+        std::vector<std::shared_ptr<const IImage>> frames;
+        std::promise<std::filesystem::path>        promise;
+    };
+
+    void evict_();
+    void dispatch_(Job&& job);
+    void write_(Job& job);
+    void run_();
+
+    Capacity              capacity_;
+    std::filesystem::path directory_;
+    std::string           prefix_;
+
+    mutable std::mutex                        mutex_;
+    std::deque<std::shared_ptr<const IImage>> ring_;
+    std::size_t                               ring_bytes_ = 0;
+    std::vector<Job>                          pending_;
+
+    std::mutex              writer_mutex_;
+    std::condition_variable writer_cv_;
+    std::deque<Job>         writer_queue_;
+    bool                    stop_requested_ = false;
+    std::thread             writer_;
+};
+
+}  // namespace camera
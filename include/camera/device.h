@@ -3,10 +3,13 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <ArenaApi.h>
 
+#include "camera/enums.h"
 #include "camera/image.h"
+#include "camera/stats.h"
 #include "camera/lucid/types.h"
 
 namespace camera {
@@ -52,10 +55,10 @@ struct DeviceParameters {
 
     /**
      * @brief Enables the unconditional action command mode where action commands are processed even when the primary control channel is closed.
-     * @param value "On" / "Off"
-     * @note default is "On".
+     * @param value Switch::ON / Switch::OFF
+     * @note default is Switch::ON.
      */
-    std::string action_unconditional_mode = "On";
+    Switch action_unconditional_mode = Switch::ON;
 
     /**
      * @brief Count of frames processed per second.
@@ -66,17 +69,17 @@ struct DeviceParameters {
 
     /**
      * @brief Acquisition mode of the device.
-     * @param value ["Continuous" / "SingleFrame" / "MultiFrame"]. Continuous acquires images continuously. SingleFrame acquires 1 image before stopping acquisition. MultiFrame acquires a specified number of images before stopping acquisition.
-     * @note default is "Continuous".
+     * @param value AcquisitionMode::CONTINUOUS / AcquisitionMode::SINGLE_FRAME / AcquisitionMode::MULTI_FRAME. Continuous acquires images continuously. SingleFrame acquires 1 image before stopping acquisition. MultiFrame acquires a specified number of images before stopping acquisition.
+     * @note default is AcquisitionMode::CONTINUOUS.
      */
-    std::string acquisition_mode = "Continuous";
+    AcquisitionMode acquisition_mode = AcquisitionMode::CONTINUOUS;
 
     /**
      * @brief Acquisition start mode of the device.
-     * @param value [in] "Normal" / "LowLatency"
-     * @note default is "Normal".
+     * @param value AcquisitionStartMode::NORMAL / AcquisitionStartMode::LOW_LATENCY
+     * @note default is AcquisitionStartMode::NORMAL.
      */
-    std::string acquisition_start_mode = "Normal";
+    AcquisitionStartMode acquisition_start_mode = AcquisitionStartMode::NORMAL;
 
     /**
      * @brief Ratio to combine adjacent pixels in the horizontal direction into a single binned pixel. This is a technique in digital imaging where adjacent pixels in the horizontal direction are combined to form a single "binned" pixel. It could result in increased sensitivity and reduced noise, but with a lower resolution in the horizontal dimension.
@@ -91,17 +94,17 @@ struct DeviceParameters {
 
     /**
      * @brief Logics for combining the horizontal pixels together.
-     * @param value ["Sum" / "Average"] Sum is when multiple pixels combine to form 1 pixel by summing pixels and this method could result in brighter images. Average is when multiple pixels combine to form 1 pixel by averaging pixels and this method could result in less noisy images.
-     * @note default is "Average".
+     * @param value BinningMode::SUM / BinningMode::AVERAGE. Sum is when multiple pixels combine to form 1 pixel by summing pixels and this method could result in brighter images. Average is when multiple pixels combine to form 1 pixel by averaging pixels and this method could result in less noisy images.
+     * @note default is BinningMode::AVERAGE.
      */
-    std::string binning_horizontal_mode = "Average";
+    BinningMode binning_horizontal_mode = BinningMode::AVERAGE;
 
     /**
      * @brief Binning engine controlled by the BinningHorizontal and BinningVertical features (Binning feature is not supported for formats with color processed, such as BGR8 and RGB8).
-     * @param value ["Digital" / "Sensor"] Digitals is binning performed on the FPGA and Sensor is binning performed on the sensor. To enable binning feature, please select "Digital".
-     * @note default is "Digital".
+     * @param value BinningSelector::DIGITAL / BinningSelector::SENSOR. Digitals is binning performed on the FPGA and Sensor is binning performed on the sensor. To enable binning feature, please select BinningSelector::DIGITAL.
+     * @note default is BinningSelector::DIGITAL.
      */
-    std::string binning_selector = "Digital";
+    BinningSelector binning_selector = BinningSelector::DIGITAL;
 
     /**
      * @brief Ratio to combine adjacent pixels in the vertical direction into a single binned pixel. This is a technique in digital imaging where adjacent pixels in the vertical direction are combined to form a single "binned" pixel. It could result in increased sensitivity and reduced noise, but with a lower resolution in the vertical dimension.
@@ -115,34 +118,49 @@ struct DeviceParameters {
 
     /**
      * @brief Logics for combining the vertically pixels together.
-     * @param value ["Sum" / "Average"]
+     * @param value BinningMode::SUM / BinningMode::AVERAGE
      * @details
      * "Sum" is when multiple pixels combine to form 1 pixel by summing pixels. This method will result in brighter images.
      * "Average" is when multiple pixels combine to form 1 pixel by averaging pixels. This method can result in less noisy images.
-     * @note default is "Average".
+     * @note default is BinningMode::AVERAGE.
      */
-    std::string binning_vertical_mode = "Average";
+    BinningMode binning_vertical_mode = BinningMode::AVERAGE;
+
+    /**
+     * @brief Chunks to append to the payload of every image, when chunk mode is active.
+     *      The parsed values are delivered in `IHeader::chunk`, so reading them costs no extra register access.
+     * @param value "CRC" / "ExposureTime" / "FrameCounter" / "Gain" / "Timestamp"
+     * @note default is all of the above.
+     */
+    std::vector<std::string> chunk_enable = {"CRC", "ExposureTime", "FrameCounter", "Gain", "Timestamp"};
+
+    /**
+     * @brief Activates the inclusion of chunk data in the payload of the image.
+     * @param value true / false
+     * @note default is false.
+     */
+    bool chunk_mode_active = false;
 
     /**
      * @brief
-     * @param  value ["Low" / "High"]
-     * @note default is "High".
+     * @param value ConversionGain::LOW / ConversionGain::HIGH
+     * @note default is ConversionGain::HIGH.
      */
-    std::string conversion_gain = "High";
+    ConversionGain conversion_gain = ConversionGain::HIGH;
 
     /**
      * @brief Enable auto exposure time adjustment.
-     * @param value "Continuous" / "Off"
-     * @note default is "Continuous"
+     * @param value AutoMode::CONTINUOUS / AutoMode::OFF
+     * @note default is AutoMode::CONTINUOUS.
      */
-    std::string exposure_auto = "Continuous";
+    AutoMode exposure_auto = AutoMode::CONTINUOUS;
 
     /**
      * @brief
-     * @param value "Continuous" / "Off"
-     * @note default is "Continuous"
+     * @param value AutoMode::CONTINUOUS / AutoMode::OFF
+     * @note default is AutoMode::CONTINUOUS.
      */
-    std::string exposure_auto_limit_auto = "Continuous";
+    AutoMode exposure_auto_limit_auto = AutoMode::CONTINUOUS;
 
     /**
      * @brief Least value for exposure time which could reach to under auto-exposure condition.
@@ -169,10 +187,10 @@ struct DeviceParameters {
     /**
      * @brief Mode for automatic gain balancing between the sensor color channels or taps.
      * The gain coefficients of each channel or tap are adjusted so they are matched.
-     * @param value "Continuous" / "Off"
-     * @note default is "Continuous".
+     * @param value AutoMode::CONTINUOUS / AutoMode::OFF
+     * @note default is AutoMode::CONTINUOUS.
      */
-    std::string gain_auto = "Continuous";
+    AutoMode gain_auto = AutoMode::CONTINUOUS;
 
     /**
      * @brief Controls whether the dhcp ip configuration scheme is activated on the given logical link.
@@ -210,6 +228,26 @@ struct DeviceParameters {
      */
     std::string pixel_format = "BayerRG8";
 
+    /**
+     * @brief User set of the device which caches the parameters. Once the parameters have been applied, they are saved
+     *      to the user set, and to a profile file of the host named after the serial of the device, see
+     *      `camera::profile::save()`. Opening the device with the same parameters later loads the user set in a single
+     *      command instead of writing every parameter.
+     * @param value "UserSet1" / "UserSet2", or empty to write every parameter on every open.
+     * @note default is "".
+     * @warning once loaded, the user set is checked by reading back the default user set, the image size, the pixel
+     * format, the trigger mode and whether the rate is fixed, and every parameter is written on any mismatch. other
+     * changes another host saved into the user set are not detected, unless the profile file is removed.
+     */
+    std::string profile_user_set = "";
+
+    /**
+     * @brief Directory of the host holding the profile files, see `profile_user_set`.
+     * @param value path of an existing directory, or empty for the working directory.
+     * @note default is "".
+     */
+    std::string profile_directory = "";
+
     /**
      * @brief Enable the Precision Time Protocol (PTP).
      * @param value true / false
@@ -247,10 +285,10 @@ struct DeviceParameters {
 
     /**
      * @brief Mode for handling image buffers.
-     * @param value "OldestFirst" / "OldestFirstOverwrite" / "NewestOnly"
-     * @note default is "OldestFirst".
+     * @param value StreamBufferHandlingMode::OLDEST_FIRST / StreamBufferHandlingMode::OLDEST_FIRST_OVERWRITE / StreamBufferHandlingMode::NEWEST_ONLY
+     * @note default is StreamBufferHandlingMode::OLDEST_FIRST.
      */
-    std::string stream_buffer_handling_mode = "OldestFirst";
+    StreamBufferHandlingMode stream_buffer_handling_mode = StreamBufferHandlingMode::OLDEST_FIRST;
 
     /**
      * @brief Enable to stream packets in multicast mode.
@@ -259,6 +297,30 @@ struct DeviceParameters {
      */
     bool stream_multicast_enable = false;
 
+    /**
+     * @brief Attaches to the multicast stream of a device controlled by another host or process, without taking control
+     *      of the device. The parameters are not applied to the device, and transfers are neither started nor stopped.
+     *      Frames are captured like in the normal mode, while the device sends every packet only once to all receivers.
+     * @param value true / false
+     * @note default is false.
+     * @warning the controlling host must have configured the device for multicast, see `stream_multicast_enable` and
+     * `gev_scda`. opening fails with `camera::exception::DevicecNotAccesible` while no other host controls the device,
+     * since opening it would take control.
+     */
+    bool stream_multicast_receiver_only = false;
+
+    /**
+     * @brief Recovers the device after its link is lost, such as by a reboot or a cable glitch. The device is found
+     *      again by its serial number, reopened with the same parameters and streamed again if it was streaming.
+     *      The loss is reported as a gap event at once, and the first frame after the recovery as another one, see
+     *      `GapTracker::Event`. Meanwhile `IDevice::capture()` waits for the recovery as for a frame which has not
+     *      arrived yet, throwing `camera::exception::Timeout` like any capture without a frame, so consumers need no
+     *      handling of their own for the recovery.
+     * @param value true / false
+     * @note default is false.
+     */
+    bool auto_reconnect = false;
+
     /**
      * @brief Enable to re-transmit packet if fails.
      * @param value true / false
@@ -266,6 +328,21 @@ struct DeviceParameters {
      */
     bool stream_packet_resend_enable = true;
 
+    /**
+     * @brief Size of the packets the device streams, GevSCPSPacketSize. `lucid::System::planBandwidth()` sets it with
+     *      its plan, so that a recovery of the device applies the plan again.
+     * @param value [0, X] in bytes, 0 to keep the packet size of the device
+     * @note default is 0.
+     */
+    int64_t stream_packet_size = 0;
+
+    /**
+     * @brief Delay between the packets the device streams, GevSCPD. It is only applied with `stream_packet_size`.
+     * @param value [0, X] in nanoseconds
+     * @note default is 0.
+     */
+    int64_t stream_packet_delay = 0;
+
     /**
      * @brief Pixel value that camera will try to reach by automatically adjusting the exposure time and gain values.
      * @param value [0, 255]
@@ -275,24 +352,24 @@ struct DeviceParameters {
 
     /**
      * @brief Control mode for starting streaming of data blocks (images) out of the device.
-     * @param value "Basic" / "Automatic" / "UserControlled"
-     * @note default is "UserControlled"
+     * @param value TransferControlMode::BASIC / TransferControlMode::AUTOMATIC / TransferControlMode::USER_CONTROLLED
+     * @note default is TransferControlMode::USER_CONTROLLED.
      */
-    std::string transfer_control_mode = "UserControlled";
+    TransferControlMode transfer_control_mode = TransferControlMode::USER_CONTROLLED;
 
     /**
      * @brief
-     * @param value "Continuous" / "MultiBlock"
-     * @note default is "Continuous".
+     * @param value TransferOperationMode::CONTINUOUS / TransferOperationMode::MULTI_BLOCK
+     * @note default is TransferOperationMode::CONTINUOUS.
      */
-    std::string transfer_operation_mode = "Continuous";
+    TransferOperationMode transfer_operation_mode = TransferOperationMode::CONTINUOUS;
 
     /**
      * @brief
-     * @param value "RisingEdge" / "FallingEdge" / "AnyEdge"
-     * @note default is "RisingEdge"
+     * @param value TriggerActivation::RISING_EDGE / TriggerActivation::FALLING_EDGE / TriggerActivation::ANY_EDGE
+     * @note default is TriggerActivation::RISING_EDGE.
      */
-    std::string trigger_activation = "RisingEdge";
+    TriggerActivation trigger_activation = TriggerActivation::RISING_EDGE;
 
     /**
      * @brief
@@ -301,33 +378,42 @@ struct DeviceParameters {
      */
     double trigger_delay = 0.0;
 
+    /**
+     * @brief Name of the trigger group the device joins. Action commands fired for the group trigger every device of
+     *      the group, and no other device. The group mask of the device is assigned by the system at open, replacing
+     *      `action_group_mask`.
+     * @param value any name, or empty to stay out of every group.
+     * @note default is "".
+     */
+    std::string trigger_group = "";
+
     /**
      * @brief
-     * @param value "Off" / "OneLine"
-     * @note default is "Off"
+     * @param value TriggerLatency::OFF / TriggerLatency::ONE_LINE
+     * @note default is TriggerLatency::OFF.
      */
-    std::string trigger_latency = "Off";
+    TriggerLatency trigger_latency = TriggerLatency::OFF;
 
     /**
      * @brief Activate trigger mode.
-     * @param value "On" / "Off"
-     * @note default is "Off".
+     * @param value Switch::ON / Switch::OFF
+     * @note default is Switch::OFF.
      */
-    std::string trigger_mode = "Off";
+    Switch trigger_mode = Switch::OFF;
 
     /**
      * @brief
-     * @param value "Off" / "ReadOut" / "PreviousFrame"
-     * @note default is "Off"
+     * @param value TriggerOverlap::OFF / TriggerOverlap::READ_OUT / TriggerOverlap::PREVIOUS_FRAME
+     * @note default is TriggerOverlap::OFF.
      */
-    std::string trigger_overlap = "Off";
+    TriggerOverlap trigger_overlap = TriggerOverlap::OFF;
 
     /**
      * @brief Trigger type of the device.
-     * @param value [in] "AcquisitionStart" / "FrameStart" / "FrameBurstStart" / "ExposureActive" / "LineStart"
-     * @note default is "FrameStart".
+     * @param value TriggerSelector::ACQUISITION_START / TriggerSelector::FRAME_START / TriggerSelector::FRAME_BURST_START / TriggerSelector::EXPOSURE_ACTIVE / TriggerSelector::LINE_START
+     * @note default is TriggerSelector::FRAME_START.
      */
-    std::string trigger_selector = "FrameStart";
+    TriggerSelector trigger_selector = TriggerSelector::FRAME_START;
 
     /**
      * @brief Trigger mode of the device. The feature is only activated when trigger mode is enabled.
@@ -358,6 +444,7 @@ struct DeviceInfo {
     std::string ipv4                  = "";
     std::string subnet_mask           = "";
     std::string gateway               = "";
+    std::string host_ipv4             = "";  // address of the host interface the device is reached through
     double      rate                  = 0.0;
     int         max_width             = 0;
     int         max_height            = 0;
@@ -383,6 +470,8 @@ class IDevice {
 
     /**
      * @brief Opens device. devices must be opened before IDevice::stream().
+     * @throw camera::exception::GenericException if the parameters have been applied, but their profile could not be
+     *      saved, see `DeviceParameters::profile_user_set`. The device is open nonetheless.
      *
      */
     virtual void open() = 0;
@@ -424,6 +513,13 @@ class IDevice {
      */
     [[nodiscard]] virtual std::shared_ptr<IImage> capture(const int64_t timeout_ms = 1000UL) = 0;
 
+    /**
+     * @brief Gets a snapshot of the streaming health of the device. Reading it does not access the device.
+     *
+     * @return DeviceStats empty for devices which do not keep statistics.
+     */
+    [[nodiscard]] virtual DeviceStats stats() const { return DeviceStats{}; }
+
     virtual void configurePersistentIpAddress(const std::string& ipv4, const std::string& subnet) = 0;
 
    protected:
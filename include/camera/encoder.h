@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Encodes frames to JPEG on a pool of worker threads, using libjpeg-turbo.
+ *      Every worker keeps its own compressor handle and scratch buffers for its whole lifetime.
+ *      Encoded frames are delivered in the order they were submitted, regardless of which worker finished first.
+ *
+ * @details
+ * supported inputs are `PixelFormat::MONO8`, `PixelFormat::RGB8`, `PixelFormat::BGR8` and `PixelFormat::BAYER_RG8`,
+ * which is demosaiced by the encoder before compression.
+ */
+class JpegEncoder {
+   public:
+    struct Options {
+        std::size_t num_threads = 2;
+        int         quality     = 85;     // [1, 100]
+        std::size_t max_pending = 8;      // submitted frames not yet delivered, before `submit()` rejects
+        bool        fast_dct    = false;  // trades accuracy for speed
+    };
+
+    struct Frame {
+        IHeader              header;
+        std::size_t          rows = 0;
+        std::size_t          cols = 0;
+        std::vector<uint8_t> jpeg;
+        uint64_t             encode_ns  = 0;  // time spent in the compressor, including demosaicing
+        uint64_t             latency_ns = 0;  // time from `submit()` until the frame is ready for delivery
+        bool                 failed     = false;  // the compressor failed, in which case `jpeg` is empty
+    };
+
+    using Callback = std::function<void(Frame&& frame)>;
+
+    /**
+     * @param options [in]
+     * @param callback [in] Invoked with every encoded frame in submission order, from one of the workers. It may submit
+     * and flush.
+     */
+    JpegEncoder(const Options& options, Callback callback);
+    ~JpegEncoder();
+
+    JpegEncoder(const JpegEncoder&)            = delete;
+    JpegEncoder& operator=(const JpegEncoder&) = delete;
+
+    /**
+     * @brief Queues the frame for encoding. It never blocks the caller.
+     * @param image [in]
+     * @return false if too many frames are pending, in which case the frame is not encoded.
+     * @throw camera::exception::InvalidConfigValue if the pixel format is not supported.
+     */
+    bool submit(std::shared_ptr<const IImage> image);
+
+    /**
+     * @brief Blocks until every submitted frame has been delivered. Called from the callback, it delivers the frames
+     *      submitted up to then before returning.
+     */
+    void flush();
+
+   private:
+    struct Job {
+        uint64_t                      index = 0;
+        std::shared_ptr<const IImage> image;
+        uint64_t                      submitted_ns = 0;
+    };
+
+    void run_();
+    void deliver_(const uint64_t index, Frame&& frame);
+    void deliverReady_(std::unique_lock<std::mutex>& lock);
+
+    Options  options_;
+    Callback callback_;
+
+    std::mutex              queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<Job>         queue_;
+    uint64_t                next_index_     = 0;
+    bool                    stop_requested_ = false;
+
+    std::atomic<std::size_t> pending_{0};  // raised under `queue_mutex_`, lowered under `delivery_mutex_`
+
+    std::mutex                delivery_mutex_;
+    std::condition_variable   delivery_cv_;
+    std::condition_variable   flush_cv_;
+    std::map<uint64_t, Frame> completed_;
+    uint64_t                  next_delivery_ = 0;
+    bool                      delivering_    = false;  // a thread is running the callback
+
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace camera
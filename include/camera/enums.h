@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace camera {
+
+/**
+ * @brief Values of the symbolic parameters of `DeviceParameters`. Each value maps to the GenICam name of its
+ *      enumeration entry through `nameOf()`, which is resolved at compile time.
+ */
+enum class Switch
+{
+    OFF,
+    ON,
+};
+
+enum class AutoMode
+{
+    OFF,
+    CONTINUOUS,
+};
+
+enum class AcquisitionMode
+{
+    CONTINUOUS,
+    SINGLE_FRAME,
+    MULTI_FRAME,
+};
+
+enum class AcquisitionStartMode
+{
+    NORMAL,
+    LOW_LATENCY,
+};
+
+enum class BinningMode
+{
+    SUM,
+    AVERAGE,
+};
+
+enum class BinningSelector
+{
+    DIGITAL,
+    SENSOR,
+};
+
+enum class ConversionGain
+{
+    LOW,
+    HIGH,
+};
+
+enum class StreamBufferHandlingMode
+{
+    OLDEST_FIRST,
+    OLDEST_FIRST_OVERWRITE,
+    NEWEST_ONLY,
+};
+
+enum class TransferControlMode
+{
+    BASIC,
+    AUTOMATIC,
+    USER_CONTROLLED,
+};
+
+enum class TransferOperationMode
+{
+    CONTINUOUS,
+    MULTI_BLOCK,
+};
+
+enum class TriggerActivation
+{
+    RISING_EDGE,
+    FALLING_EDGE,
+    ANY_EDGE,
+};
+
+enum class TriggerLatency
+{
+    OFF,
+    ONE_LINE,
+};
+
+enum class TriggerOverlap
+{
+    OFF,
+    READ_OUT,
+    PREVIOUS_FRAME,
+};
+
+enum class TriggerSelector
+{
+    ACQUISITION_START,
+    FRAME_START,
+    FRAME_BURST_START,
+    EXPOSURE_ACTIVE,
+    LINE_START,
+};
+
+/**
+ * @brief GenICam names of the values of an enum, in the order of its values.
+ */
+template<typename E>
+struct EnumNames;
+
+template<>
+struct EnumNames<Switch> {
+    static constexpr std::array<const char*, 2> names = {"Off", "On"};
+};
+
+template<>
+struct EnumNames<AutoMode> {
+    static constexpr std::array<const char*, 2> names = {"Off", "Continuous"};
+};
+
+template<>
+struct EnumNames<AcquisitionMode> {
+    static constexpr std::array<const char*, 3> names = {"Continuous", "SingleFrame", "MultiFrame"};
+};
+
+template<>
+struct EnumNames<AcquisitionStartMode> {
+    static constexpr std::array<const char*, 2> names = {"Normal", "LowLatency"};
+};
+
+template<>
+struct EnumNames<BinningMode> {
+    static constexpr std::array<const char*, 2> names = {"Sum", "Average"};
+};
+
+template<>
+struct EnumNames<BinningSelector> {
+    static constexpr std::array<const char*, 2> names = {"Digital", "Sensor"};
+};
+
+template<>
+struct EnumNames<ConversionGain> {
+    static constexpr std::array<const char*, 2> names = {"Low", "High"};
+};
+
+template<>
+struct EnumNames<StreamBufferHandlingMode> {
+    static constexpr std::array<const char*, 3> names = {"OldestFirst", "OldestFirstOverwrite", "NewestOnly"};
+};
+
+template<>
+struct EnumNames<TransferControlMode> {
+    static constexpr std::array<const char*, 3> names = {"Basic", "Automatic", "UserControlled"};
+};
+
+template<>
+struct EnumNames<TransferOperationMode> {
+    static constexpr std::array<const char*, 2> names = {"Continuous", "MultiBlock"};
+};
+
+template<>
+struct EnumNames<TriggerActivation> {
+    static constexpr std::array<const char*, 3> names = {"RisingEdge", "FallingEdge", "AnyEdge"};
+};
+
+template<>
+struct EnumNames<TriggerLatency> {
+    static constexpr std::array<const char*, 2> names = {"Off", "OneLine"};
+};
+
+template<>
+struct EnumNames<TriggerOverlap> {
+    static constexpr std::array<const char*, 3> names = {"Off", "ReadOut", "PreviousFrame"};
+};
+
+template<>
+struct EnumNames<TriggerSelector> {
+    static constexpr std::array<const char*, 5> names = {"AcquisitionStart", "FrameStart", "FrameBurstStart",
+                                                         "ExposureActive", "LineStart"};
+};
+
+/**
+ * @brief Gets the GenICam name of a value.
+ * @param value [in]
+ * @return const char* such as "RisingEdge" for `TriggerActivation::RISING_EDGE`.
+ */
+template<typename E>
+constexpr const char* nameOf(const E value) {
+    return EnumNames<E>::names[static_cast<std::size_t>(value)];
+}
+
+/**
+ * @brief Gets the value of a GenICam name.
+ * @param name [in]
+ * @param value [out] unchanged if the name is unknown.
+ * @return true if the name is known.
+ */
+template<typename E>
+bool valueOf(const std::string& name, E& value) {
+    for (std::size_t i = 0; i < EnumNames<E>::names.size(); i++) {
+        if (name == EnumNames<E>::names[i]) {
+            value = static_cast<E>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace camera
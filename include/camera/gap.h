@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Detects frames lost by a device stream, as they happen.
+ *      Every captured frame is checked for a skipped sequence number and for missing data. The loss counters of the
+ *      stream, which are kept by the host, are only read when a frame reveals a loss, so the hot path touches nothing
+ *      but atomic counters.
+ *
+ * @details
+ * sequence numbers are expected to increase by one. a number not greater than the previous one is taken as a restart
+ * of the stream, such as after a reconnect or a wrap of the block id, and is not counted as a gap.
+ * a frame is observed by a single capture thread at a time, whereas counters may be read from any thread.
+ */
+class GapTracker {
+   public:
+    struct Event {
+        enum class Kind
+        {
+            SKIPPED,         // sequence numbers were skipped
+            INCOMPLETE,      // the frame arrived with missing data
+            LOST_FRAMES,     // the stream reported lost frames
+            MISSED_PACKETS,  // the stream reported missed packets
+            DISCONNECTED,    // the link of the stream was lost, which stops the frames until it resumes
+            RECONNECTED,     // the stream resumed after its link was lost
+        };
+
+        Kind     kind;
+        uint64_t seq   = 0;  // sequence number of the frame which revealed the loss, or of the last one before it
+        uint64_t stamp = 0;  // nanoseconds
+        uint64_t count = 0;  // frames or packets lost. for `Kind::RECONNECTED`, frames estimated from the frame rate
+    };
+
+    struct Stats {
+        uint64_t frames         = 0;  // frames observed
+        uint64_t gaps           = 0;  // runs of skipped sequence numbers
+        uint64_t skipped        = 0;  // sequence numbers skipped in total
+        uint64_t incomplete     = 0;  // frames with missing data
+        uint64_t restarts       = 0;  // sequence numbers which went backwards
+        uint64_t lost_frames    = 0;  // reported by the stream
+        uint64_t missed_packets = 0;  // reported by the stream
+        uint64_t disconnects    = 0;  // links lost
+        uint64_t reconnects     = 0;  // streams resumed after their link was lost
+    };
+
+    using Callback = std::function<void(const Event& event)>;
+
+    /**
+     * @brief Reads the cumulative loss counters of the stream, as lost frames and missed packets.
+     *      Returns false if they could not be read.
+     */
+    using StreamCounters = std::function<bool(int64_t& lost_frames, int64_t& missed_packets)>;
+
+    GapTracker() = default;
+
+    GapTracker(const GapTracker&)            = delete;
+    GapTracker& operator=(const GapTracker&) = delete;
+
+    /**
+     * @brief Sets the callback invoked with every loss, from the capture thread, or from the thread which detected a
+     *      lost link. It must not block.
+     *      The callback must be set while no frame is observed, such as before streaming.
+     * @param callback [in] null disables the events.
+     */
+    void setCallback(Callback callback);
+
+    /**
+     * @brief Sets how the loss counters of the stream are read when a frame reveals a loss.
+     *      It must be set while no frame is observed, such as before streaming.
+     * @param counters [in] null disables the stream counters.
+     */
+    void setStreamCounters(StreamCounters counters);
+
+    /**
+     * @brief Checks a captured frame for losses.
+     * @param image [in]
+     * @return true if the frame revealed a loss.
+     */
+    bool observe(const IImage& image);
+
+    /**
+     * @brief Reports the loss of the link of the stream, as it is detected. It may be called from any thread.
+     */
+    void disconnected();
+
+    /**
+     * @brief Reports the first frame of a stream resumed after its link was lost.
+     * @param image [in]
+     * @param count [in] Frames lost while the link was down, as far as they are known.
+     */
+    void reconnected(const IImage& image, const uint64_t count);
+
+    /**
+     * @brief Forgets the previous sequence number and the baseline of the stream counters, which restart with a new
+     *      stream. The accumulated counters are kept.
+     */
+    void restart();
+
+    /**
+     * @brief Gets the counters accumulated since construction.
+     * @return Stats
+     */
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    void emit_(const Event::Kind kind, const IImage& image, const uint64_t count) const;
+    void sampleStream_(const IImage& image);
+
+    Callback       callback_ = nullptr;
+    StreamCounters counters_ = nullptr;
+
+    std::atomic<bool>     has_seq_{false};
+    std::atomic<uint64_t> last_seq_{0};
+    std::atomic<uint64_t> last_stamp_{0};
+    std::atomic<int64_t>  last_lost_frames_{0};
+    std::atomic<int64_t>  last_missed_packets_{0};
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> incomplete_{0};
+    std::atomic<uint64_t> restarts_{0};
+    std::atomic<uint64_t> lost_frames_{0};
+    std::atomic<uint64_t> missed_packets_{0};
+    std::atomic<uint64_t> disconnects_{0};
+    std::atomic<uint64_t> reconnects_{0};
+};
+
+}  // namespace camera
@@ -1,24 +1,83 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace camera {
 
+class BufferPool;
+
+/**
+ * @brief Releases image memory. Buffers acquired from a `camera::BufferPool` are handed back to the pool instead of
+ * being freed, so that the next capture can reuse them. Memory owned elsewhere, such as a shared mapping, is handed
+ * to its release function.
+ */
+struct BufferDeleter {
+    using Release = std::function<void(uint8_t* ptr)>;
+
+    BufferDeleter() = default;
+    BufferDeleter(std::default_delete<uint8_t[]>) {}
+    BufferDeleter(std::shared_ptr<BufferPool> owner, const std::size_t size)
+        : pool(std::move(owner))
+        , capacity(size) {}
+    explicit BufferDeleter(Release release_function)
+        : release(std::move(release_function)) {}
+
+    void operator()(uint8_t* ptr) const;
+
+    std::shared_ptr<BufferPool> pool     = nullptr;
+    std::size_t                 capacity = 0;
+    Release                     release  = nullptr;
+};
+
+using Buffer = std::unique_ptr<uint8_t[], BufferDeleter>;
+
+/**
+ * @brief Layout of the pixels in `IImage::data`.
+ */
+enum class PixelFormat
+{
+    UNKNOWN,
+    MONO8,
+    MONO16,
+    BAYER_RG8,
+    BAYER_RG16,
+    RGB8,
+    BGR8,
+};
+
+/**
+ * @brief Per-frame metadata appended to the payload by the device, when chunk mode is active.
+ */
+struct IChunk {
+    bool     valid         = false;  // whether the frame carried chunk data
+    double   exposure_time = 0.0;    // microseconds
+    double   gain          = 0.0;    // dB
+    uint64_t frame_id      = 0;
+    uint64_t timestamp     = 0;      // nanoseconds
+    uint32_t crc           = 0;
+};
+
 struct IHeader {
-    uint64_t stamp;  // nanoseconds
+    uint64_t stamp;              // nanoseconds
+    uint64_t dequeue_stamp = 0;  // nanoseconds of the host `CLOCK_MONOTONIC`, when a capture took it from the stream
     uint64_t seq;
+    IChunk   chunk;
 };
 
 struct IImage {
-    bool                       complete = false;
-    IHeader                    header;
-    std::size_t                rows  = 0;  // height
-    std::size_t                cols  = 0;  // width
-    std::size_t                step  = 0;
-    std::size_t                depth = 0;
-    std::unique_ptr<uint8_t[]> data;
+    bool        complete = false;
+    IHeader     header;
+    std::size_t rows   = 0;  // height
+    std::size_t cols   = 0;  // width
+    std::size_t step   = 0;
+    std::size_t depth  = 0;
+    PixelFormat format = PixelFormat::UNKNOWN;
+    Buffer      data;
+
+    std::vector<std::shared_ptr<IImage>> levels;  // downscaled copies attached by `camera::Pyramid`, finest first
 };
 
 }  // namespace camera
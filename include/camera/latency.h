@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Histogram of latencies in nanoseconds, with buckets of logarithmic scale and linear sub-buckets.
+ *      Every power of two is split into 64 sub-buckets, which bounds the error of a percentile to 1/64 of its value
+ *      over a range up to 2^40 ns, about 18 minutes. Larger values fall into the last bucket.
+ *
+ * @details
+ * the buckets are a fixed array of atomic counters, so recording neither allocates nor locks and may happen from any
+ * thread.
+ */
+class LatencyHistogram {
+   public:
+    struct Summary {
+        uint64_t count   = 0;
+        int64_t  p50_ns  = 0;
+        int64_t  p99_ns  = 0;
+        int64_t  p999_ns = 0;
+        int64_t  max_ns  = 0;
+    };
+
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&)            = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Records a latency. Negative values, such as from clocks slightly out of sync, are recorded as 0.
+     * @param ns [in]
+     */
+    void record(const int64_t ns);
+
+    /**
+     * @brief Gets the latency below which a given share of the recorded values fall.
+     * @param percentile [in] (0, 100]
+     * @return int64_t nanoseconds, the middle of the bucket. 0 if nothing has been recorded.
+     */
+    [[nodiscard]] int64_t percentile(const double percentile) const;
+
+    /**
+     * @brief Gets the count, p50, p99, p999 and max of the recorded values.
+     * @return Summary
+     */
+    [[nodiscard]] Summary summary() const;
+
+    /**
+     * @brief Forgets every recorded value. Values recorded meanwhile may be kept or lost.
+     */
+    void reset();
+
+   private:
+    static constexpr int         kSubBucketBits = 6;
+    static constexpr int         kMaxExponent   = 40;
+    static constexpr std::size_t kSubBuckets    = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBuckets       = kSubBuckets * (kMaxExponent - kSubBucketBits + 1);
+
+    static std::size_t bucketOf(const uint64_t ns);
+    static int64_t     valueOf(const std::size_t bucket);
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t>                       count_{0};
+    std::atomic<int64_t>                        max_ns_{0};
+};
+
+/**
+ * @brief Latency histograms of the stages a frame passes from its exposure until the application is done with it.
+ *      The first two stages are recorded by the device on every capture, and the application may add stages of its
+ *      own after them.
+ *
+ * @details
+ * every stage is measured from the time a capture took the frame from the stream, `IHeader::dequeue_stamp`, so its
+ * histogram holds the latency up to the end of the stage, and the difference between stages is the time spent in
+ * between. the stream does not stamp when it received a frame, so the time a frame waited in the stream for a capture
+ * is part of the `DEQUEUE` stage, together with the exposure and the transfer. that stage is measured back from the
+ * dequeue, and is only recorded once the device stamps can be converted to the host monotonic clock, such as by
+ * `lucid::PtpMonitor::toMonotonic()`.
+ * stages and the clock must be set up while no frame is recorded, such as before streaming.
+ */
+class FrameLatency {
+   public:
+    static constexpr std::size_t kMaxStages = 8;
+
+    enum Stage : std::size_t
+    {
+        DEQUEUE = 0,  // from the device stamp, the start of the exposure, until a capture took it from the stream
+        CAPTURE = 1,  // from the dequeue until `IDevice::capture()` returned the frame, mostly its copy
+    };
+
+    struct Report {
+        std::string               name;
+        LatencyHistogram::Summary summary;
+    };
+
+    /**
+     * @brief Converts a device stamp, such as `IHeader::stamp`, to nanoseconds of the host `CLOCK_MONOTONIC`.
+     */
+    using DeviceClock = std::function<uint64_t(uint64_t stamp)>;
+
+    FrameLatency();
+
+    FrameLatency(const FrameLatency&)            = delete;
+    FrameLatency& operator=(const FrameLatency&) = delete;
+
+    /**
+     * @brief Sets how device stamps are converted to host time, which enables the `DEQUEUE` stage.
+     * @param clock [in] null disables the stage.
+     */
+    void setDeviceClock(DeviceClock clock);
+
+    /**
+     * @brief Adds a stage of the application, after the ones recorded already.
+     * @param name [in]
+     * @return std::size_t id of the stage.
+     * @throw std::length_error if there are `kMaxStages` stages already.
+     */
+    std::size_t addStage(const std::string& name);
+
+    /**
+     * @brief Records the stages of a capture. Called by the device when `IDevice::capture()` returns.
+     * @param image [in]
+     * @param returned_ns [in] Host monotonic time the capture returned at.
+     */
+    void captured(const IImage& image, const uint64_t returned_ns);
+
+    /**
+     * @brief Records the end of a stage of a frame.
+     * @param stage [in] id of the stage.
+     * @param image [in]
+     * @param done_ns [in] Host monotonic time the stage ended at.
+     */
+    void record(const std::size_t stage, const IImage& image, const uint64_t done_ns);
+
+    /**
+     * @brief Records the end of a stage of a frame, now.
+     * @param stage [in] id of the stage.
+     * @param image [in]
+     */
+    void record(const std::size_t stage, const IImage& image);
+
+    /**
+     * @brief Gets the histogram of a stage.
+     * @param stage [in] id of the stage.
+     * @return const LatencyHistogram&
+     */
+    [[nodiscard]] const LatencyHistogram& histogram(const std::size_t stage) const;
+
+    /**
+     * @brief Gets the summary of every stage, in the order of the stages.
+     * @return std::vector<Report>
+     */
+    [[nodiscard]] std::vector<Report> report() const;
+
+    /**
+     * @brief Forgets every recorded latency, and keeps the stages.
+     */
+    void reset();
+
+   private:
+    DeviceClock clock_ = nullptr;
+
+    std::array<std::string, kMaxStages>      names_;
+    std::array<LatencyHistogram, kMaxStages> histograms_;
+    std::atomic<std::size_t>                 stages_{0};
+};
+
+}  // namespace camera
@@ -2,9 +2,14 @@
 
 #include <ArenaApi.h>
 
+#include <array>
 #include <cstdint>
+#include <mutex>
+#include <optional>
 #include <string>
 
+#include "camera/enums.h"
+
 namespace camera {
 namespace lucid {
 
@@ -80,9 +85,9 @@ class Config {
      * @brief Enables the unconditional action command mode where action commands are processed even when the primary control channel is closed.
      * It allows a camera to accept action from an application without write access.
      * The device key, group key, and group mask must match similar settings in the system's TL node map.
-     * @param value [in] "On" / "Off"
+     * @param value [in] Switch::ON / Switch::OFF
      */
-    void setActionUnconditionalMode(const char* value);
+    void setActionUnconditionalMode(const Switch value);
 
     /**
      * @brief Gets the currently configured state of action-unconditional-mode.
@@ -122,9 +127,9 @@ class Config {
 
     /**
      * @brief Specifies the acquisition mode of the current device. It helps determine the number of frames to acquire during each acquisition sequence.
-     * @param value [in] "Continuous" / "SingleFrame" / "MultiFrame"
+     * @param value [in] AcquisitionMode::CONTINUOUS / AcquisitionMode::SINGLE_FRAME / AcquisitionMode::MULTI_FRAME
      */
-    void setAcquisitionMode(const char* value);
+    void setAcquisitionMode(const AcquisitionMode value);
 
     /**
      * @brief Gets the currently configured state of acquisition-mode.
@@ -134,9 +139,9 @@ class Config {
 
     /**
      * @brief Specifies the acquisition start mode.
-     * @param value [in] "Normal" / "LowLatency"
+     * @param value [in] AcquisitionStartMode::NORMAL / AcquisitionStartMode::LOW_LATENCY
      */
-    void setAcquisitionStartMode(const char* value);
+    void setAcquisitionStartMode(const AcquisitionStartMode value);
 
     /**
      * @brief Gets the currently configured state of acquisition-start-mode.
@@ -164,10 +169,10 @@ class Config {
      * @brief Selects how to combine the horizontal pixels together.
      * (Binning is not supported in in color processed pixel formats like BGR8 and RGB8)
      * @details https://support.thinklucid.com/knowledgebase/binning-and-decimation-on-lucid-cameras/?gclid=EAIaIQobChMIhojWovfk_AIVVMFMAh3jeApuEAAYASAAEgLdf_D_BwE
-     * @param value [in] "Sum" (is when multiple pixels combine to form 1 pixel by summing pixels. This method will result in brighter images)
-     *                    / "Average" (is when multiple pixels combine to form 1 pixel by averaging pixels. This method can result in less noisy images)
+     * @param value [in] BinningMode::SUM (is when multiple pixels combine to form 1 pixel by summing pixels. This method will result in brighter images)
+     *                    / BinningMode::AVERAGE (is when multiple pixels combine to form 1 pixel by averaging pixels. This method can result in less noisy images)
      */
-    void setBinningHorizontalMode(const char* value);
+    void setBinningHorizontalMode(const BinningMode value);
 
     /**
      * @brief Gets the currently configured state of binning-horizontal-mode.
@@ -179,10 +184,10 @@ class Config {
      * @brief Selects which binning engine is controlled by the BinningHorizontal and BinningVertical features.
      * (Binning is not supported in in color processed pixel formats like BGR8 and RGB8)
      * @details https://support.thinklucid.com/knowledgebase/binning-and-decimation-on-lucid-cameras/?gclid=EAIaIQobChMIhojWovfk_AIVVMFMAh3jeApuEAAYASAAEgLdf_D_BwE
-     * @param value [in] "Digital" (is binning performed on the FPGA)
-     *                    / "Sensor" (is binning performed on the sensor)
+     * @param value [in] BinningSelector::DIGITAL (is binning performed on the FPGA)
+     *                    / BinningSelector::SENSOR (is binning performed on the sensor)
      */
-    void setBinningSelector(const char* value);
+    void setBinningSelector(const BinningSelector value);
 
     /**
      * @brief Gets the currently configured state of binning-selector.
@@ -210,9 +215,9 @@ class Config {
      * @brief Selects how to combine the vertical pixels together.
      * (Binning is not supported in in color processed pixel formats like BGR8 and RGB8)
      * @details https://support.thinklucid.com/knowledgebase/binning-and-decimation-on-lucid-cameras/?gclid=EAIaIQobChMIhojWovfk_AIVVMFMAh3jeApuEAAYASAAEgLdf_D_BwE
-     * @param value [in] "Sum" / "Average"
+     * @param value [in] BinningMode::SUM / BinningMode::AVERAGE
      */
-    void setBinningVerticalMode(const char* value);
+    void setBinningVerticalMode(const BinningMode value);
 
     /**
      * @brief Gets the currently configured state of binning-vertical-mode.
@@ -220,12 +225,49 @@ class Config {
      */
     [[nodiscard]] std::string getBinningVerticalMode() const;
 
+    /**
+     * @brief Sets whether the selected chunk is included in the payload data.
+     * @param value [in]
+     * @note the chunk must be selected by `Config::setChunkSelector()` beforehand.
+     */
+    void setChunkEnable(const bool value);
+
+    /**
+     * @brief Gets whether the selected chunk is included in the payload data.
+     * @return bool
+     */
+    [[nodiscard]] bool getChunkEnable() const;
+
+    /**
+     * @brief Activates the inclusion of chunk data in the payload of the image.
+     * @param value [in]
+     */
+    void setChunkModeActive(const bool value);
+
+    /**
+     * @brief Gets the currently configured state of chunk-mode-active.
+     * @return bool
+     */
+    [[nodiscard]] bool getChunkModeActive() const;
+
+    /**
+     * @brief Selects which chunk to enable or control.
+     * @param value [in] "CRC" / "ExposureTime" / "Gain" / "FrameCounter" / "Timestamp" / ...
+     */
+    void setChunkSelector(const char* value);
+
+    /**
+     * @brief Gets the currently selected chunk.
+     * @return "CRC" / "ExposureTime" / "Gain" / "FrameCounter" / "Timestamp" / ...
+     */
+    [[nodiscard]] std::string getChunkSelector() const;
+
     /**
      * @brief
-     * @param value [in] "High" / "Low"
+     * @param value [in] ConversionGain::HIGH / ConversionGain::LOW
      * @warning only supports `helios` camera.
      */
-    void setConversionGain(const char* value);
+    void setConversionGain(const ConversionGain value);
 
     /**
      * @brief.
@@ -240,6 +282,12 @@ class Config {
      */
     [[nodiscard]] std::string getDeviceAccessStatus() const;
 
+    /**
+     * @brief Gets the speed of transmission negotiated on the link of the device.
+     * @return int64_t in bytes per second
+     */
+    [[nodiscard]] int64_t getDeviceLinkSpeed() const;
+
     /**
      * @brief Retrieves the device temperature in degree Celsius.
      * @param value [in] [1, 30] (experimentally recommended)
@@ -248,9 +296,9 @@ class Config {
 
     /**
      * @brief Sets the automatic exposure mode.
-     * @param value [in] "Continuous" / "Off"
+     * @param value [in] AutoMode::CONTINUOUS / AutoMode::OFF
      */
-    void setExposureAuto(const char* value);
+    void setExposureAuto(const AutoMode value);
 
     /**
      * @brief Gets the currently configured state of auto-exposure feature.
@@ -260,9 +308,9 @@ class Config {
 
     /**
      * @brief Enables or disables to limit exposure time automatically.
-     * @param value [in] "Continuous" / "Off"
+     * @param value [in] AutoMode::CONTINUOUS / AutoMode::OFF
      */
-    void setExposureAutoLimitAuto(const char* value);
+    void setExposureAutoLimitAuto(const AutoMode value);
 
     /**
      * @brief Gets the currently configured state of auto-exposure time limit feature.
@@ -308,9 +356,9 @@ class Config {
 
     /**
      * @brief Sets the automatic gain control mode.
-     * @param value [in] "Continuous" / "Off"
+     * @param value [in] AutoMode::CONTINUOUS / AutoMode::OFF
      */
-    void setGainAuto(const char* value);
+    void setGainAuto(const AutoMode value);
 
     /**
      * @brief Gets the currently configured state of auto-gain feature.
@@ -438,6 +486,18 @@ class Config {
      */
     [[nodiscard]] std::string getGevSCDAStr() const;
 
+    /**
+     * @brief Sets the delay inserted between the packets of the stream channel, to throttle its bandwidth.
+     * @param value [in] in timestamp ticks, which are nanoseconds on lucid devices.
+     */
+    void setGevSCPD(const int64_t value);
+
+    /**
+     * @brief Gets the currently configured inter-packet delay of the stream channel.
+     * @return int64_t in timestamp ticks
+     */
+    [[nodiscard]] int64_t getGevSCPD() const;
+
     /**
      * @brief
      * @param value [in]
@@ -480,6 +540,12 @@ class Config {
      */
     [[nodiscard]] std::string getPixelFormat() const;
 
+    /**
+     * @brief Gets the number of bytes transferred for each image on the stream channel, including chunk data.
+     * @return int64_t
+     */
+    [[nodiscard]] int64_t getPayloadSize() const;
+
     /**
      * @brief Enables the Precision Time Protocol (PTP).
      * @param value [in] true / false
@@ -509,6 +575,12 @@ class Config {
      */
     [[nodiscard]] std::string getPtpStatus() const;
 
+    /**
+     * @brief Gets the estimated offset of the device clock from the PTP master clock.
+     * @return int64_t in nanoseconds
+     */
+    [[nodiscard]] int64_t getPtpOffsetFromMaster() const;
+
     /**
      * @brief Flips horizontally the image sent by the device.
      * @param value [in]
@@ -585,9 +657,9 @@ class Config {
     /**
      * @brief Available buffer handling modes of this data stream.
      * @details https://www.flir.com/support-center/iis/machine-vision/application-note/understanding-buffer-handling/
-     * @param value [in] "OldestFirst" / "OldestFirstOverwrite" / "NewestOnly"
+     * @param value [in] StreamBufferHandlingMode::OLDEST_FIRST / StreamBufferHandlingMode::OLDEST_FIRST_OVERWRITE / StreamBufferHandlingMode::NEWEST_ONLY
      */
-    void setStreamBufferHandlingMode(const char* value);
+    void setStreamBufferHandlingMode(const StreamBufferHandlingMode value);
 
     /**
      * @brief Gets the currently configured state of stream-buffer-handling-mode.
@@ -607,6 +679,12 @@ class Config {
      */
     [[nodiscard]] int64_t getStreamMissedPacketCount() const;
 
+    /**
+     * @brief Gets the accumulated number of packet resend requests sent to the device in total.
+     * @return >=0
+     */
+    [[nodiscard]] int64_t getStreamResendRequestCount() const;
+
     /**
      * @brief Controls whether the device will stream in multicast or unicast mode.
      * @param value [in] true / false
@@ -643,11 +721,22 @@ class Config {
      */
     [[nodiscard]] int64_t getTargetBrightness() const;
 
+    /**
+     * @brief Latches the current value of the device clock into TimestampLatchValue.
+     */
+    void executeTimestampLatch();
+
+    /**
+     * @brief Gets the value of the device clock latched by `Config::executeTimestampLatch()`.
+     * @return int64_t in nanoseconds
+     */
+    [[nodiscard]] int64_t getTimestampLatchValue() const;
+
     /**
      * @brief Selects the control method for the transfers.
-     * @param value [in] "Basic" / "Automatic" / "UserControlled"
+     * @param value [in] TransferControlMode::BASIC / TransferControlMode::AUTOMATIC / TransferControlMode::USER_CONTROLLED
      */
-    void setTransferControlMode(const char* value);
+    void setTransferControlMode(const TransferControlMode value);
 
     /**
      * @brief Gets the currently configured state of transfer-control-mode.
@@ -657,9 +746,9 @@ class Config {
 
     /**
      * @brief Sets the operation mode of transfer.
-     * @param value [in] "Continuous" / "MultiBlock"
+     * @param value [in] TransferOperationMode::CONTINUOUS / TransferOperationMode::MULTI_BLOCK
      */
-    void setTransferOperationMode(const char* value);
+    void setTransferOperationMode(const TransferOperationMode value);
 
     /**
      * @brief Gets the currently configured state of transfer-operation-mode.
@@ -681,9 +770,9 @@ class Config {
 
     /**
      * @brief Selects the activation mode of the trigger to start the timer.
-     * @param value [in] "RisingEdge" / "FallingEdge" / "AnyEdge"
+     * @param value [in] TriggerActivation::RISING_EDGE / TriggerActivation::FALLING_EDGE / TriggerActivation::ANY_EDGE
      */
-    void setTriggerActivation(const char* value);
+    void setTriggerActivation(const TriggerActivation value);
 
     /**
      * @brief Gets the currently configured state of trigger-activation.
@@ -712,10 +801,10 @@ class Config {
 
     /**
      * @brief Enables low latency trigger mode.
-     * @param value [in] "Off" / "OneLine"
-     * @warning To use this feature, TriggerOverlap parameter must be set with "Off".
+     * @param value [in] TriggerLatency::OFF / TriggerLatency::ONE_LINE
+     * @warning To use this feature, TriggerOverlap parameter must be set with TriggerOverlap::OFF.
      */
-    void setTriggerLatency(const char* value);
+    void setTriggerLatency(const TriggerLatency value);
 
     /**
      * @brief Gets the currently configured state of trigger-latency.
@@ -725,9 +814,9 @@ class Config {
 
     /**
      * @brief Controls the On/Off status of the current trigger.
-     * @param value [in] "On" / "Off"
+     * @param value [in] Switch::ON / Switch::OFF
      */
-    void setTriggerMode(const char* value);
+    void setTriggerMode(const Switch value);
 
     /**
      * @brief Gets the currently configured state of trigger-mode.
@@ -738,9 +827,9 @@ class Config {
     /**
      * @brief Specifies the tpye of trigger overlap permitted with the previous frame or line.
      * This defines when a valid trigger will be accepted (or latched) for a new frame or a new line.
-     * @param value [in] "Off" / "ReadOut" / "PreviousFrame"
+     * @param value [in] TriggerOverlap::OFF / TriggerOverlap::READ_OUT / TriggerOverlap::PREVIOUS_FRAME
      */
-    void setTriggerOverlap(const char* value);
+    void setTriggerOverlap(const TriggerOverlap value);
 
     /**
      * @brief Gets the currently configured trigger-overlap.
@@ -750,9 +839,9 @@ class Config {
 
     /**
      * @brief Selects the specific trigger type to configure.
-     * @param value [in] "AcquisitionStart" / "FrameStart" / "FrameBurstStart" / "ExposureActive" / "LineStart"
+     * @param value [in] TriggerSelector::ACQUISITION_START / TriggerSelector::FRAME_START / TriggerSelector::FRAME_BURST_START / TriggerSelector::EXPOSURE_ACTIVE / TriggerSelector::LINE_START
      */
-    void setTriggerSelector(const char* value);
+    void setTriggerSelector(const TriggerSelector value);
 
     /**
      * @brief Gets the currently configured state of trigger-selector.
@@ -772,6 +861,40 @@ class Config {
      */
     [[nodiscard]] std::string getTriggerSource() const;
 
+    /**
+     * @brief Selects the user set to load, save or make default.
+     * @param value [in] "Default" / "UserSet1" / "UserSet2"
+     */
+    void setUserSetSelector(const char* value);
+
+    /**
+     * @brief Gets the currently selected user set.
+     * @return "Default" / "UserSet1" / "UserSet2"
+     */
+    [[nodiscard]] std::string getUserSetSelector() const;
+
+    /**
+     * @brief Selects the user set loaded when the device powers up.
+     * @param value [in] "Default" / "UserSet1" / "UserSet2"
+     */
+    void setUserSetDefault(const char* value);
+
+    /**
+     * @brief Gets the user set loaded when the device powers up.
+     * @return "Default" / "UserSet1" / "UserSet2"
+     */
+    [[nodiscard]] std::string getUserSetDefault() const;
+
+    /**
+     * @brief Loads the selected user set into the active settings of the device.
+     */
+    void executeUserSetLoad();
+
+    /**
+     * @brief Saves the active settings of the device into the selected user set.
+     */
+    void executeUserSetSave();
+
     /**
      * @brief Sets width of the image provided by the device in pixels.
      * @param value [in] desired width.
@@ -791,8 +914,48 @@ class Config {
     [[nodiscard]] int64_t getWidthMax() const;
 
    private:
+    /**
+     * @brief Enumeration node of the device, with the integer value of the entry of every value of its enum.
+     *      Both are looked up on the first write of the node, and only read afterwards.
+     */
+    template<typename E>
+    struct Enumeration {
+        std::once_flag                                                 once;
+        GenApi::CEnumerationPtr                                        node;
+        std::array<std::optional<int64_t>, EnumNames<E>::names.size()> values;  // empty for entries the device lacks
+    };
+
+    /**
+     * @brief Sets an enumeration node by the integer value of the entry of a value.
+     * @param enumeration [in] Cache of the node.
+     * @param node [in]
+     * @param value [in]
+     * @throw camera::exception::InvalidConfigValue if the node or the entry does not exist, or the write fails.
+     */
+    template<typename E>
+    void setEnumeration_(Enumeration<E>& enumeration, const char* node, const E value);
+
     Arena::ISystem* system_;
     Arena::IDevice* device_;
+
+    Enumeration<Switch>                   action_unconditional_mode_;
+    Enumeration<AcquisitionMode>          acquisition_mode_;
+    Enumeration<AcquisitionStartMode>     acquisition_start_mode_;
+    Enumeration<BinningMode>              binning_horizontal_mode_;
+    Enumeration<BinningSelector>          binning_selector_;
+    Enumeration<BinningMode>              binning_vertical_mode_;
+    Enumeration<ConversionGain>           conversion_gain_;
+    Enumeration<AutoMode>                 exposure_auto_;
+    Enumeration<AutoMode>                 exposure_auto_limit_auto_;
+    Enumeration<AutoMode>                 gain_auto_;
+    Enumeration<StreamBufferHandlingMode> stream_buffer_handling_mode_;
+    Enumeration<TransferControlMode>      transfer_control_mode_;
+    Enumeration<TransferOperationMode>    transfer_operation_mode_;
+    Enumeration<TriggerActivation>        trigger_activation_;
+    Enumeration<TriggerLatency>           trigger_latency_;
+    Enumeration<Switch>                   trigger_mode_;
+    Enumeration<TriggerOverlap>           trigger_overlap_;
+    Enumeration<TriggerSelector>          trigger_selector_;
 };
 
 }  // namespace lucid
@@ -4,13 +4,25 @@
 
 #include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
 
 #include <camera/exception.h>
 
 #include <camera/device.h>
+#include <camera/gap.h>
 #include <camera/image.h>
+#include <camera/latency.h>
+#include <camera/pool.h>
+#include <camera/stats.h>
 #include <camera/system.h>
 
 #include <camera/lucid/config.hpp>
@@ -18,12 +30,36 @@
 namespace camera {
 namespace lucid {
 
+/**
+ * @brief Resolves the name of a trigger group to its action group mask.
+ */
+using TriggerGroupResolver = std::function<int64_t(const std::string& group)>;
+
+/**
+ * @brief Finds a device on the network again by its serial number, waiting at most the timeout for replies.
+ */
+using DeviceLocator = std::function<std::optional<Arena::DeviceInfo>(const std::string& serial, const int timeout_ms)>;
+
 class Device: public IDevice {
    public:
-    Device(Arena::ISystem* system, Arena::DeviceInfo arena_info, DeviceInfo custom_info);
+    struct Recovery {
+        bool     recovering     = false;
+        uint64_t reconnects     = 0;  // recoveries completed by a frame
+        uint64_t attempts       = 0;  // attempts to reopen the device
+        int64_t  downtime_ns    = 0;  // latest recovery, from the loss of the link until the first frame
+        int64_t  first_frame_ns = 0;  // latest recovery, from reopening the device until the first frame
+    };
+
+    Device(Arena::ISystem* system, Arena::DeviceInfo arena_info, DeviceInfo custom_info,
+           TriggerGroupResolver resolver = nullptr, DeviceLocator locator = nullptr);
 
     virtual ~Device() override;
 
+    /**
+     * @brief Sets configuration parameters for device, after checking them against the spec of its model.
+     * @param param [in]
+     * @throw camera::exception::InvalidConfigValue if a parameter is out of the limits of the model.
+     */
     void config(const DeviceParameters& param) override;
 
     void open() override;
@@ -38,19 +74,157 @@ class Device: public IDevice {
 
     bool isAvailable() override;
 
+    /**
+     * @brief Gets the info of the device, whose address and rate a recovery may update.
+     *      Every update is published as a new copy, and the previous ones are kept, so the returned reference stays
+     *      valid and unchanged for the lifetime of the device.
+     * @return const DeviceInfo&
+     */
+    [[nodiscard]] const DeviceInfo& info() const override;
+
     [[nodiscard]] std::shared_ptr<IImage> capture(const int64_t timeout_ms = 1000UL) override;
 
+    /**
+     * @brief Gets a snapshot of the streaming health of the device. The counters of the stream are sampled by
+     *      `Device::capture()` once per second, so they lag the stream by up to a second.
+     * @return DeviceStats
+     */
+    [[nodiscard]] DeviceStats stats() const override;
+
     void configurePersistentIpAddress(const std::string& ipv4, const std::string& subnet);
 
+    /**
+     * @brief Gets the configuration interface of the device, which is available once the device is opened.
+     *      Releasing or recovering the device invalidates it, and settings written through it are lost by a recovery.
+     * @return std::shared_ptr<Config>
+     */
+    [[nodiscard]] std::shared_ptr<Config> getConfig() const;
+
+    /**
+     * @brief Runs a function on the configuration of the opened device, which releasing and recovering the device
+     *      wait for. Background threads which access the device periodically use it, since the configuration
+     *      returned by `Device::getConfig()` outlives the device it was created for.
+     * @param function [in]
+     * @return false if the device is not opened, or lost and not reopened yet, in which case the function is not run.
+     */
+    bool withConfig(const std::function<void(Config& config)>& function);
+
+    /**
+     * @brief Writes a planned stream setting to the device, and keeps it in the parameters, so that a recovery of the
+     *      device applies it again. See `DeviceParameters::stream_packet_size` and `DeviceParameters::trigger_delay`.
+     * @param packet_size [in] GevSCPSPacketSize
+     * @return int64_t the packet size the device accepted, which it rounds to its step.
+     * @throw camera::exception::InvalidConfigValue if the device is not opened or rejects the value.
+     */
+    int64_t applyPacketSize(const int64_t packet_size);
+
+    /**
+     * @param packet_delay [in] GevSCPD, in nanoseconds
+     * @throw camera::exception::InvalidConfigValue if the device is not opened or rejects the value.
+     */
+    void applyPacketDelay(const int64_t packet_delay);
+
+    /**
+     * @param trigger_delay [in] microseconds
+     * @throw camera::exception::InvalidConfigValue if the device is not opened or rejects the value.
+     */
+    void applyTriggerDelay(const double trigger_delay);
+
+    /**
+     * @brief Gets the loss tracking of the stream, which observes every captured frame.
+     * @return GapTracker&
+     */
+    [[nodiscard]] GapTracker& gaps() { return gaps_; }
+
+    /**
+     * @brief Gets the latency histograms of the frames, which every capture records.
+     * @return FrameLatency&
+     */
+    [[nodiscard]] FrameLatency& latency() { return latency_; }
+
+    /**
+     * @brief Gets the state of the automatic recovery, see `DeviceParameters::auto_reconnect`.
+     * @return Recovery
+     */
+    [[nodiscard]] Recovery recovery() const;
+
+   protected:
+    /**
+     * @brief Applies the parameters which only exist on some models, after the common ones.
+     *      Models are specialized by `DeviceOf`, which selects them at compile time.
+     * @param config [in]
+     * @param param [in]
+     */
+    virtual void applyModelParams_(Config& config, const DeviceParameters& param);
+
+    /**
+     * @brief Decodes the PFNC pixel format of a captured image. Models only decode the formats they can stream.
+     * @param pfnc [in]
+     * @return PixelFormat::UNKNOWN for formats without a counterpart.
+     */
+    virtual PixelFormat pixelFormatOf_(const uint64_t pfnc) const;
+
+    /**
+     * @brief Starts and stops the transfer of images, for models which control it apart from the stream.
+     * @param device [in]
+     */
+    virtual void startTransfer_(Arena::IDevice* device);
+    virtual void stopTransfer_(Arena::IDevice* device);
+
+    /**
+     * @brief Stops the recovery thread, which calls into the model. Derived classes stop it on destruction.
+     */
+    void stopWatching_();
+
    private:
-    void applyParamsOnDevice_();
-
-    Arena::ISystem*         arena_system_ = nullptr;
-    Arena::IDevice*         arena_device_ = nullptr;
-    Arena::DeviceInfo       arena_info_;
-    std::shared_ptr<Config> config_ = nullptr;
-    DeviceParameters        param_;
-    std::atomic<bool>       is_available_to_capture_;
+    void        publishInfo_(const std::function<void(DeviceInfo& info)>& update);
+    bool        open_();
+    void        stream_();
+    void        lose_();
+    bool        recover_();
+    void        watch_();
+    DeviceParameters      profileParams_() const;
+    std::filesystem::path profilePath_() const;
+    bool                  loadProfile_();
+    bool                  isProfileLoaded_() const;
+    void                  saveProfile_();
+    void                  applyStreamParams_();
+    void                  applyParamsOnDevice_();
+
+    Arena::ISystem*             arena_system_ = nullptr;
+    Arena::IDevice*             arena_device_ = nullptr;
+    Arena::DeviceInfo           arena_info_;
+    std::shared_ptr<Config>     config_ = nullptr;
+    std::shared_ptr<BufferPool> pool_   = nullptr;
+    TriggerGroupResolver        resolver_;
+    DeviceParameters            param_;
+    GapTracker                  gaps_;
+    StatsRecorder               stats_;
+    FrameLatency                latency_;
+    std::atomic<bool>           is_available_to_capture_;
+
+    DeviceLocator             locator_;
+    mutable std::shared_mutex device_mutex_;  // guards the arena device and its config, which a recovery replaces
+    std::size_t               num_buffer_   = 5UL;
+    bool                      is_streaming_ = false;
+
+    std::mutex                     info_mutex_;  // serializes publishing the info
+    std::deque<DeviceInfo>         infos_;       // every published info, which references may still point to
+    std::atomic<const DeviceInfo*> published_info_{nullptr};
+
+    std::mutex              watch_mutex_;
+    std::condition_variable watch_cv_;  // notified when the link is lost, a recovery ends, or watching stops
+    bool                    is_lost_        = false;
+    bool                    stop_requested_ = false;
+    std::thread             watcher_;
+
+    std::atomic<bool>     recovering_{false};
+    std::atomic<uint64_t> reconnects_{0};
+    std::atomic<uint64_t> attempts_{0};
+    std::atomic<int64_t>  lost_ns_{0};      // steady time the link was lost at
+    std::atomic<int64_t>  reopened_ns_{0};  // steady time the device was reopened at, 0 once a frame has arrived
+    std::atomic<int64_t>  downtime_ns_{0};
+    std::atomic<int64_t>  first_frame_ns_{0};
 };
 
 }  // namespace lucid
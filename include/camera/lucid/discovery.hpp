@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <camera/device.h>
+
+#include <camera/lucid/system.hpp>
+
+namespace camera {
+namespace lucid {
+
+/**
+ * @brief Keeps a table of the devices on the network up to date from a background thread.
+ *      The system is scanned continuously with a short timeout, and every change of the table is reported through
+ *      callbacks, so applications react to devices instead of blocking their startup on a scan.
+ *
+ * @details
+ * devices are keyed by their serial number. a device departs once it has been missing from
+ * `Options::departure_scans` consecutive scans, which keeps a single lost discovery reply from being reported as a
+ * departure. a device reassigned an address, or reached through another host interface, is reported as an address
+ * change. a replacement device has a serial of its own, so it is reported as an arrival.
+ * since every scan refreshes the devices known to the system, `System::init()` finds a device as soon as it has
+ * arrived.
+ * callbacks are invoked from the worker thread, in the order of the changes, and must not block.
+ */
+class Discovery {
+   public:
+    struct Options {
+        int         scan_timeout_ms = 100;   // time a scan waits for discovery replies
+        int         interval_ms     = 1000;  // pause between scans, which bounds the discovery traffic
+        std::size_t departure_scans = 3;     // consecutive scans a device must be missing from to depart
+    };
+
+    struct Callbacks {
+        std::function<void(const DeviceInfo& info)>                                 arrival;
+        std::function<void(const DeviceInfo& info)>                                 departure;
+        std::function<void(const DeviceInfo& previous, const DeviceInfo& current)> address_change;
+    };
+
+    /**
+     * @param system [in] System to scan, which must outlive the discovery.
+     * @param options [in]
+     * @param callbacks [in] Any of them may be null.
+     */
+    Discovery(System& system, const Options& options, Callbacks callbacks);
+    ~Discovery();
+
+    Discovery(const Discovery&)            = delete;
+    Discovery& operator=(const Discovery&) = delete;
+
+    /**
+     * @brief Gets the devices present, keyed by serial number.
+     * @return std::map<std::string, DeviceInfo>
+     */
+    [[nodiscard]] std::map<std::string, DeviceInfo> devices() const;
+
+    /**
+     * @brief Gets a device, if it is present.
+     * @param serial [in]
+     * @return std::optional<DeviceInfo>
+     */
+    [[nodiscard]] std::optional<DeviceInfo> find(const std::string& serial) const;
+
+    /**
+     * @brief Waits until a device is present.
+     * @param serial [in]
+     * @param timeout_ms [in]
+     * @return std::optional<DeviceInfo> empty if the device did not arrive in time.
+     */
+    [[nodiscard]] std::optional<DeviceInfo> waitFor(const std::string& serial, const int64_t timeout_ms) const;
+
+    /**
+     * @brief Gets the number of scans completed since construction.
+     * @return uint64_t
+     */
+    [[nodiscard]] uint64_t scans() const;
+
+   private:
+    struct Entry {
+        DeviceInfo  info;
+        std::size_t missed = 0;  // consecutive scans the device was missing from
+    };
+
+    void update_(const std::vector<DeviceInfo>& scanned);
+    void run_();
+
+    System&   system_;
+    Options   options_;
+    Callbacks callbacks_;
+
+    mutable std::mutex              mutex_;
+    mutable std::condition_variable changed_cv_;  // notified after every scan
+    std::map<std::string, Entry>    table_;
+    uint64_t                        scans_ = 0;
+
+    std::condition_variable stop_cv_;
+    bool                    stop_requested_ = false;
+    std::thread             worker_;
+};
+
+}  // namespace lucid
+}  // namespace camera
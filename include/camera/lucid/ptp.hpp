@@ -0,0 +1,128 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <camera/device.h>
+
+#include <camera/lucid/device.hpp>
+
+namespace camera {
+namespace lucid {
+
+/**
+ * @brief Watches the PTP synchronization of devices and maps their timestamps to host time.
+ *      A background thread samples the PTP status and offset of every device, and latches the device clock together
+ *      with the host clocks. A linear fit over the recent latches converts frame stamps to `CLOCK_REALTIME` and
+ *      `CLOCK_MONOTONIC` without any register access per frame.
+ *
+ * @details
+ * devices are addressed by their index in the vector passed to the constructor. the monitor only holds them weakly,
+ * and skips them while they are closed or being recovered.
+ * the latches are discarded whenever the PTP status of a device changes or its offset from the master jumps, since the
+ * device clock is then stepped, and the mapping is fitted anew from the following latches.
+ * a sample costs four register accesses per device, so the default interval keeps the load on the control channel
+ * negligible.
+ */
+class PtpMonitor {
+   public:
+    struct Options {
+        int64_t     interval_ms   = 1000;       // between samples of a device
+        std::size_t window        = 32;         // latches the mapping is fitted over
+        int64_t     max_offset_ns = 1'000'000;  // jump of the offset from the master that restarts the mapping
+    };
+
+    struct Sync {
+        std::string status                = "";  // "Master" / "Slave" / "Listening" / "Uncalibrated" / ...
+        int64_t     offset_from_master_ns = 0;
+        double      drift_ppm             = 0.0;  // rate of the device clock relative to the host realtime clock
+        double      residual_ns           = 0.0;  // rms error of the mapping over its window
+        uint64_t    samples               = 0;
+        uint64_t    failures              = 0;    // samples that could not be read from the device
+        uint64_t    updated_ns            = 0;    // host realtime of the latest sample
+
+        [[nodiscard]] bool isLocked() const { return status == "Slave" || status == "Master"; }
+    };
+
+    /**
+     * @param devices [in] Devices to monitor, which are sampled while they are opened.
+     * @param options [in]
+     */
+    PtpMonitor(const std::vector<std::shared_ptr<IDevice>>& devices, const Options& options);
+    ~PtpMonitor();
+
+    PtpMonitor(const PtpMonitor&)            = delete;
+    PtpMonitor& operator=(const PtpMonitor&) = delete;
+
+    /**
+     * @brief Gets the latest synchronization state of a device.
+     * @param device [in] Index of the device.
+     * @return Sync
+     */
+    [[nodiscard]] Sync sync(const std::size_t device) const;
+
+    /**
+     * @brief Converts a device stamp, such as `IHeader::stamp`, to host `CLOCK_REALTIME`.
+     *      Until the first latch of the device, the stamp is returned unchanged.
+     * @param device [in] Index of the device.
+     * @param stamp [in] nanoseconds
+     * @return uint64_t nanoseconds
+     */
+    [[nodiscard]] uint64_t toRealtime(const std::size_t device, const uint64_t stamp) const;
+
+    /**
+     * @brief Converts a device stamp, such as `IHeader::stamp`, to host `CLOCK_MONOTONIC`.
+     *      Until the first latch of the device, the stamp is returned unchanged.
+     * @param device [in] Index of the device.
+     * @param stamp [in] nanoseconds
+     * @return uint64_t nanoseconds
+     */
+    [[nodiscard]] uint64_t toMonotonic(const std::size_t device, const uint64_t stamp) const;
+
+   private:
+    struct Latch {
+        int64_t device_ns    = 0;
+        int64_t realtime_ns  = 0;
+        int64_t monotonic_ns = 0;
+    };
+
+    /**
+     * @brief Linear fit of host time over device time, around the mean of the window.
+     */
+    struct Mapping {
+        bool    valid          = false;
+        int64_t device_ns      = 0;
+        int64_t realtime_ns    = 0;
+        int64_t monotonic_ns   = 0;
+        double  realtime_rate  = 1.0;
+        double  monotonic_rate = 1.0;
+    };
+
+    struct Channel {
+        std::weak_ptr<Device> device;
+        std::deque<Latch>     latches;
+        Mapping               mapping;
+        Sync                  sync;
+    };
+
+    void sample_(Channel& channel);
+    void fit_(Channel& channel);
+    void run_();
+
+    Options              options_;
+    std::vector<Channel> channels_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    bool                    stop_requested_ = false;
+    std::thread             worker_;
+};
+
+}  // namespace lucid
+}  // namespace camera
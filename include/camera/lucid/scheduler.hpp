@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <camera/device.h>
+#include <camera/image.h>
+#include <camera/system.h>
+
+namespace camera {
+namespace lucid {
+
+/**
+ * @brief Fires action commands at a fixed rate from a dedicated thread.
+ *      Every command is issued `Options::lead_periods` periods before it executes, and carries its absolute execute
+ *      time, so the jitter of the host scheduler only shifts when a command is sent, not when the devices trigger.
+ *
+ * @details
+ * execute times are in PTP nanoseconds, which the host clock is expected to follow, as with the PTP grandmaster
+ * synchronized to the host. the lead is bounded by the action queue depth of the slowest device, since a device drops
+ * commands beyond its queue.
+ * `ActionScheduler::observe()` compares the stamps of the resulting frames with their scheduled times.
+ */
+class ActionScheduler {
+   public:
+    struct Options {
+        int64_t     period_ns    = 100'000'000;
+        std::size_t lead_periods = 2;  // clamped to the action queue depth of the devices
+        int64_t     start_ns     = 0;  // execute time of the first command. 0 starts at the next period after the lead
+
+        // trigger groups the commands target, see `DeviceParameters::trigger_group`. empty targets the group mask of
+        // the system, so schedulers of different groups can run at different rates on one system
+        std::vector<std::string> groups;
+    };
+
+    struct Stats {
+        uint64_t    fired         = 0;    // commands sent
+        uint64_t    missed        = 0;    // commands skipped, as the host woke up after their execute time
+        uint64_t    observed      = 0;    // frames passed to `ActionScheduler::observe()`
+        double      mean_ns       = 0.0;  // mean deviation of frame stamps from their scheduled times
+        double      stddev_ns     = 0.0;
+        int64_t     max_abs_ns    = 0;
+        int64_t     queue_depth   = 0;    // smallest action queue size across the devices
+        std::size_t lead_periods  = 0;    // lead in effect
+        int64_t     last_fired_ns = 0;    // execute time of the latest command
+    };
+
+    using Clock = std::function<int64_t()>;
+
+    /**
+     * @param system [in] System that sends the action commands.
+     * @param devices [in] Opened devices listening to the commands, whose action queue depth bounds the lead.
+     * @param options [in]
+     * @param clock [in] Source of the current PTP time. Defaults to the host realtime clock.
+     * @throw camera::exception::InvalidConfigValue if the period is not positive.
+     */
+    ActionScheduler(ISystem& system, const std::vector<std::shared_ptr<IDevice>>& devices, const Options& options,
+                    Clock clock = nullptr);
+    ~ActionScheduler();
+
+    ActionScheduler(const ActionScheduler&)            = delete;
+    ActionScheduler& operator=(const ActionScheduler&) = delete;
+
+    /**
+     * @brief Starts firing commands. It has no effect if the scheduler is already running.
+     */
+    void start();
+
+    /**
+     * @brief Stops firing commands. Commands already sent still execute on the devices.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the execute time of the command of the given index.
+     * @param index [in]
+     * @return int64_t
+     */
+    [[nodiscard]] int64_t scheduledAt(const uint64_t index) const;
+
+    /**
+     * @brief Records the deviation of a frame stamp from the scheduled time of the command it was triggered by.
+     * @param image [in]
+     * @param delay_ns [in] Trigger delay configured on the device that captured the frame.
+     * @return Deviation in nanoseconds.
+     */
+    int64_t observe(const IImage& image, const int64_t delay_ns = 0);
+
+    /**
+     * @brief Gets the counters accumulated since construction.
+     * @return Stats
+     */
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    void fire_(const int64_t execute_ns);
+    void run_();
+
+    ISystem&             system_;
+    Options              options_;
+    Clock                clock_;
+    int64_t              queue_depth_ = 0;
+    std::atomic<int64_t> origin_ns_{0};  // execute time of the command of index 0
+    uint64_t             next_index_ = 0;
+
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    bool                    stop_requested_ = false;
+    std::thread             worker_;
+
+    std::atomic<uint64_t> fired_{0};
+    std::atomic<uint64_t> missed_{0};
+    std::atomic<int64_t>  last_fired_ns_{0};
+
+    mutable std::mutex stats_mutex_;
+    uint64_t           observed_   = 0;
+    double             mean_ns_    = 0.0;
+    double             m2_         = 0.0;  // sum of squared differences from the mean
+    int64_t            max_abs_ns_ = 0;
+};
+
+}  // namespace lucid
+}  // namespace camera
@@ -1,20 +1,142 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
+#include "camera/device.h"
 #include "camera/lucid/types.h"
 
 namespace camera {
 namespace lucid {
 
+/**
+ * @brief Pixel formats a model can stream, as bits of `Spec::pixel_formats`.
+ */
+namespace format {
+enum : uint32_t
+{
+    MONO8          = 1U << 0,
+    MONO10P        = 1U << 1,
+    MONO12P        = 1U << 2,
+    MONO16         = 1U << 3,
+    BAYER_RG8      = 1U << 4,
+    BAYER_RG10P    = 1U << 5,
+    BAYER_RG12P    = 1U << 6,
+    BAYER_RG16     = 1U << 7,
+    RGB8           = 1U << 8,
+    BGR8           = 1U << 9,
+    YCBCR422_8     = 1U << 10,
+    COORD3D_C16    = 1U << 11,
+    COORD3D_ABC16  = 1U << 12,
+    COORD3D_ABCY16 = 1U << 13,
+    CONFIDENCE16   = 1U << 14,
+};
+}  // namespace format
+
+constexpr int64_t kGigabitLinkSpeed = 125'000'000;  // bytes per second
+
 struct Spec {
     DeviceType  device_type;
     std::size_t max_rate;
     std::size_t max_width;
     std::size_t max_height;
+    uint32_t    pixel_formats;       // bits of `format`
+    std::size_t max_bits_per_pixel;  // of the widest pixel format
+    std::size_t max_payload_bytes;   // image of the maximal size in the widest pixel format, excluding chunk data
+    std::size_t sensor_bit_depth;
+    int64_t     link_speed;          // bytes per second
+};
+
+/**
+ * @brief Defines the spec of a model, deriving its maximal payload from the other limits.
+ */
+constexpr Spec defineSpec(const DeviceType device_type, const std::size_t max_rate, const std::size_t max_width,
+                          const std::size_t max_height, const uint32_t pixel_formats,
+                          const std::size_t max_bits_per_pixel, const std::size_t sensor_bit_depth,
+                          const int64_t link_speed) {
+    return Spec{
+        device_type,
+        max_rate,
+        max_width,
+        max_height,
+        pixel_formats,
+        max_bits_per_pixel,
+        max_width * max_height * max_bits_per_pixel / 8,
+        sensor_bit_depth,
+        link_speed,
+    };
+}
+
+// indexed by `Model`
+inline constexpr std::array<Spec, 4> kSpecs = {
+    // UNKNOWN
+    defineSpec(DeviceType::UNDEFINED, 0, 0, 0, 0, 0, 0, 0),
+    // TRI028S-C, whose widest format is RGB8
+    defineSpec(DeviceType::RGB_CAMERA, 39, 1936, 1464,
+               format::MONO8 | format::MONO10P | format::MONO12P | format::MONO16 | format::BAYER_RG8
+                   | format::BAYER_RG10P | format::BAYER_RG12P | format::BAYER_RG16 | format::RGB8 | format::BGR8
+                   | format::YCBCR422_8,
+               24, 12, kGigabitLinkSpeed),
+    // PHX016S-C, whose widest format is RGB8
+    defineSpec(DeviceType::RGB_CAMERA, 71, 1440, 1080,
+               format::MONO8 | format::MONO10P | format::MONO12P | format::MONO16 | format::BAYER_RG8
+                   | format::BAYER_RG10P | format::BAYER_RG12P | format::BAYER_RG16 | format::RGB8 | format::BGR8
+                   | format::YCBCR422_8,
+               24, 12, kGigabitLinkSpeed),
+    // HTP003S-001, whose widest format is Coord3D_ABCY16
+    defineSpec(DeviceType::TOF_CAMERA, 103, 640, 480,
+               format::MONO8 | format::MONO16 | format::COORD3D_C16 | format::COORD3D_ABC16 | format::COORD3D_ABCY16
+                   | format::CONFIDENCE16,
+               64, 12, kGigabitLinkSpeed),
 };
+static_assert(kSpecs[static_cast<std::size_t>(Model::HTP003S_001)].device_type == DeviceType::TOF_CAMERA,
+              "specs must be in the order of models");
+
+/**
+ * @brief Gets the spec of a model, at compile time if the model is known then.
+ * @param model [in]
+ * @return the spec of `Model::UNKNOWN` for models out of range.
+ */
+constexpr Spec specOf(const Model model) {
+    const auto index = static_cast<std::size_t>(model);
+    return (index < kSpecs.size()) ? kSpecs[index] : kSpecs[static_cast<std::size_t>(Model::UNKNOWN)];
+}
+
+/**
+ * @brief Gets the bit of a pixel format in `Spec::pixel_formats`.
+ * @param pixel_format [in] PFNC name, such as "BayerRG8".
+ * @return 0 if the pixel format is unknown.
+ */
+uint32_t formatBitOf(const std::string& pixel_format);
+
+/**
+ * @brief Gets the size of a pixel in a pixel format.
+ * @param pixel_format [in] PFNC name, such as "BayerRG8".
+ * @return 0 if the pixel format is unknown.
+ */
+std::size_t bitsPerPixelOf(const std::string& pixel_format);
+
+/**
+ * @brief Gets the sizes of the full-sensor images of a model in every pixel format it supports, which buffer pools
+ *      use as size classes of their own, see `camera::BufferPool`.
+ * @param spec [in]
+ * @return sizes in bytes, ascending and without duplicates.
+ */
+std::vector<std::size_t> frameSizesOf(const Spec& spec);
 
-Spec specOf(Model model);
+/**
+ * @brief Checks parameters against the limits of a model, without any access to the device.
+ *      The pixel format must be supported, the requested image must not exceed the maximal payload of the model, and
+ *      a free-running stream must fit the link. Sizes beyond the sensor are otherwise not rejected, since they are
+ *      clamped when applied. Pixel formats unknown to `formatBitOf()` are left for the device to accept or reject.
+ * @param spec [in]
+ * @param param [in]
+ * @throw camera::exception::InvalidConfigValue naming the first parameter out of the limits.
+ */
+void validate(const Spec& spec, const DeviceParameters& param);
 
 }  // namespace lucid
 }  // namespace camera
@@ -9,21 +9,90 @@
 #include "camera/lucid/spec.h"
 
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace camera {
 namespace lucid {
 
+/**
+ * @brief Constraints of `System::planBandwidth()`.
+ */
+struct BandwidthOptions {
+    int64_t max_packet_size = 9000;  // jumbo frames, clamped to the MTU of each host interface
+    double  headroom        = 0.9;   // fraction of the link capacity the streams may use together
+    double  frame_rate      = 0.0;   // frames per second of triggered devices. 0 reads AcquisitionFrameRate instead
+
+    // speed of each host interface keyed by its address, in bytes per second. interfaces not given are assumed to be
+    // as fast as the slowest link of their devices
+    std::map<std::string, int64_t> host_link_speeds;
+};
+
+/**
+ * @brief Planned stream channel settings of a device.
+ */
+struct StreamBandwidth {
+    std::string serial;
+    int64_t     payload_bytes = 0;
+    double      frame_rate    = 0.0;
+    int64_t     packet_size   = 0;  // GevSCPSPacketSize
+    int64_t     packet_delay  = 0;  // GevSCPD, in nanoseconds
+    int64_t     required      = 0;  // bytes per second on the wire
+};
+
+/**
+ * @brief Planned bandwidth of the devices sharing a host interface.
+ */
+struct LinkBandwidth {
+    std::string                  host_ipv4;
+    int64_t                      capacity = 0;  // bytes per second the streams may use together
+    int64_t                      required = 0;  // bytes per second the streams need together
+    bool                         fits     = true;
+    std::vector<StreamBandwidth> streams;
+};
+
 class System: public ISystem {
    public:
+    using InterfaceTask =
+        std::function<void(const std::string& host_ipv4, const std::vector<std::shared_ptr<IDevice>>& devices)>;
+
     System();
     virtual ~System() override;
 
+    /**
+     * @brief Creates the device of a scanned serial number. The device is created once, and every later call for the
+     *      same serial number returns it again.
+     * @param device_info [in]
+     * @return null if the serial number has not been scanned.
+     * @throw camera::exception::UnknownModel if the model is not supported.
+     */
     const std::shared_ptr<IDevice> init(DeviceInfo device_info) override;
     const std::vector<DeviceInfo>  scan(const int timeout_ms = 1000) override;
 
     void fireActionCommand(const int64_t future_time_point) override;
+
+    /**
+     * @brief Fires an action command which triggers only the devices of the trigger group.
+     *      Firing other groups than the previous command writes the group mask of the command, a node of the host
+     *      transport layer which sends nothing to the devices. Keys and devices are never written.
+     * @param group [in] Name of the group, see `DeviceParameters::trigger_group`.
+     * @param future_time_point [in]
+     */
+    void fireActionCommand(const std::string& group, const int64_t future_time_point);
+
+    /**
+     * @brief Fires a single action command which triggers the devices of all the trigger groups.
+     * @param groups [in] Names of the groups, see `DeviceParameters::trigger_group`.
+     * @param future_time_point [in]
+     */
+    void fireActionCommand(const std::vector<std::string>& groups, const int64_t future_time_point);
     void setDeviceKey(const int64_t device_key) override;
     void setGroupKey(const int64_t group_key) override;
     void setGroupMask(const int64_t group_mask) override;
@@ -33,15 +102,105 @@ class System: public ISystem {
     void configureAddressIpAuto(std::vector<DeviceInfo> devices_info);
     void configureAddressIpAuto(DeviceInfo device_info);
 
+    /**
+     * @brief Gets the action group mask of a trigger group. Every group owns one bit of the mask, which is allocated
+     *      when the group is first used. Devices outside of any group keep the bit of the default mask.
+     * @param group [in]
+     * @return int64_t
+     * @throw camera::exception::InvalidConfigValue if every bit of the mask is taken.
+     */
+    [[nodiscard]] int64_t triggerGroupMask(const std::string& group);
+
+    /**
+     * @brief Gets a device created by `System::init()`.
+     * @param serial_or_mac [in] Serial number, or MAC address as in `DeviceInfo::mac`.
+     * @return null if no device was created for it.
+     */
+    [[nodiscard]] std::shared_ptr<IDevice> find(const std::string& serial_or_mac);
+
+    /**
+     * @brief Groups devices by the host interface they are reached through, see `DeviceInfo::host_ipv4`.
+     * @param devices_info [in]
+     * @return Devices of each interface, keyed by the address of the interface.
+     */
+    [[nodiscard]] static std::map<std::string, std::vector<DeviceInfo>> groupByInterface(
+        const std::vector<DeviceInfo>& devices_info);
+
+    /**
+     * @brief Groups devices by the host interface they are reached through, see `DeviceInfo::host_ipv4`.
+     * @param devices [in]
+     * @return Devices of each interface, keyed by the address of the interface.
+     */
+    [[nodiscard]] static std::map<std::string, std::vector<std::shared_ptr<IDevice>>> groupByInterface(
+        const std::vector<std::shared_ptr<IDevice>>& devices);
+
+    /**
+     * @brief Runs a task for every host interface on a thread of its own, so that the devices of an interface are
+     *      opened, configured or streamed independently of the other interfaces. Waits for every task to finish.
+     * @param devices [in]
+     * @param task [in] Invoked with the address of an interface and its devices.
+     * @throw the first exception thrown by a task, once every task has finished.
+     */
+    static void forEachInterface(const std::vector<std::shared_ptr<IDevice>>& devices, const InterfaceTask& task);
+
+    /**
+     * @brief Shares the bandwidth of every host interface among the devices streaming through it.
+     *      Each device gets the largest packet size its interface supports, and an inter-packet delay which spreads its
+     *      packets over its share of the link, so that the streams stay within the link capacity even when all devices
+     *      send at once. Interfaces whose streams cannot fit are reported by `LinkBandwidth::fits`.
+     * @param devices [in] Opened devices, whose packet size is not auto-negotiated.
+     * @param options [in]
+     * @param apply [in] Whether to write the planned settings to the devices, which keep them for their recoveries.
+     * @return Plan of each host interface.
+     */
+    std::vector<LinkBandwidth> planBandwidth(const std::vector<std::shared_ptr<IDevice>>& devices,
+                                             const BandwidthOptions& options = {}, const bool apply = true);
+
    private:
     Arena::ISystem*   arena_system_   = nullptr;
     GenApi::INodeMap* arena_node_map_ = nullptr;
 
-    std::vector<Arena::DeviceInfo> last_scanned_devices_info_;
+    /**
+     * @brief Device known to the system, from the latest scan which found it. Devices missing from many scans in a
+     *      row are forgotten, unless they have been created by `System::init()`.
+     */
+    struct Entry {
+        Arena::DeviceInfo        arena_info;
+        DeviceInfo               info;
+        std::shared_ptr<IDevice> device = nullptr;  // created by `System::init()`
+        uint64_t                 seen   = 0;        // scan which found the device last
+    };
+
+    std::mutex                                   registry_mutex_;  // guards the registry, which discovery refreshes
+    std::unordered_map<std::string, Entry>       registry_;        // by serial
+    std::unordered_map<std::string, std::string> serials_by_mac_;
+    uint64_t                                     scans_ = 0;
+
+    std::mutex                     action_mutex_;
+    std::map<std::string, int64_t> trigger_groups_;
+    int64_t                        group_mask_         = 0x00000001;  // set by `System::setGroupMask()`
+    int64_t                        written_group_mask_ = 0x00000001;  // current value of ActionCommandGroupMask
+    GenApi::CIntegerPtr            action_group_mask_;
+    GenApi::CIntegerPtr            action_execute_time_;
+    GenApi::CCommandPtr            action_fire_;
+
+    /**
+     * @brief Reference of the system held weakly by its devices, which may outlive it. It is cleared when the system
+     *      is destroyed, once the calls of the devices in progress have returned.
+     */
+    struct Handle {
+        std::shared_mutex mutex;
+        System*           system = nullptr;
+    };
+    std::shared_ptr<Handle> handle_;
+
+    int64_t groupMaskOf_(const std::string& group);
+    void    fireAction_(const int64_t group_mask, const int64_t future_time_point);
 
-    void                     removeDuplicate_(std::vector<Arena::DeviceInfo>& arena_device_info);
-    std::shared_ptr<IDevice> updateDevice_(DeviceInfo device_info);
-    std::shared_ptr<IDevice> createDevice_(Arena::DeviceInfo arena_device_info);
+    std::vector<Entry*>              refresh_(const int timeout_ms);
+    DeviceInfo                       infoOf_(const Arena::DeviceInfo& arena_device_info);
+    std::shared_ptr<IDevice>         createDevice_(const Entry& entry);
+    std::optional<Arena::DeviceInfo> locate_(const std::string& serial, const int timeout_ms);
 };
 
 }  // namespace lucid
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <camera/device.h>
+#include <camera/image.h>
+
+namespace camera {
+namespace lucid {
+
+/**
+ * @brief Plans the trigger delays of devices sharing a host interface, so that their image bursts follow each other on
+ *      the link instead of colliding.
+ *      The time each image occupies the link is derived from the payload size, the packet size, the packet delay and
+ *      the link speed of its device. Devices are ordered within each host interface, and every device is delayed until
+ *      the burst of the previous one has finished. Devices on different interfaces do not share bandwidth and are
+ *      planned independently.
+ *
+ * @details
+ * the planned end of each burst is compared with the measured one by `TriggerPlanner::observe()`, which takes the host
+ * time a frame was received at, in the same clock as the device stamps.
+ */
+class TriggerPlanner {
+   public:
+    struct Options {
+        double guard_ratio = 0.05;  // spare link time after each burst, relative to its duration
+
+        // speed of each host interface keyed by its address, in bytes per second. interfaces not given are assumed
+        // to be as fast as the links of their devices
+        std::map<std::string, int64_t> host_link_speeds;
+    };
+
+    struct Burst {
+        std::string serial;
+        std::string host_ipv4;
+        int64_t     payload_bytes = 0;
+        int64_t     packet_size   = 0;
+        int64_t     packet_delay  = 0;  // GevSCPD, in nanoseconds
+        int64_t     link_speed    = 0;  // bytes per second the burst is sent at
+        int64_t     exposure_ns   = 0;
+        int64_t     duration_ns   = 0;  // time the image occupies the link
+        int64_t     delay_ns      = 0;  // planned trigger delay
+        int64_t     end_ns        = 0;  // planned end of the burst, from the trigger
+
+        uint64_t samples         = 0;
+        double   measured_end_ns = 0.0;  // mean time from the trigger until the frame was received
+        int64_t  measured_max_ns = 0;
+    };
+
+    /**
+     * @param devices [in] Opened devices triggered together.
+     * @param options [in]
+     */
+    TriggerPlanner(const std::vector<std::shared_ptr<IDevice>>& devices, const Options& options);
+
+    /**
+     * @brief Reads the stream settings of the devices and computes their trigger delays.
+     * @return Planned bursts, in the order of the devices.
+     * @throw camera::exception::InvalidConfigValue if a device does not report its stream settings.
+     */
+    std::vector<Burst> plan();
+
+    /**
+     * @brief Writes the planned trigger delays to the devices. Plans first if nothing has been planned yet.
+     * @throw camera::exception::InvalidConfigValue if a device is not opened.
+     */
+    void apply();
+
+    /**
+     * @brief Records when a frame of a device was received, relative to the trigger it was captured by.
+     * @param device [in] Index of the device.
+     * @param image [in]
+     * @param received_ns [in] Host time the frame was received at, in the clock of the device stamps.
+     * @return Time from the trigger until the frame was received, in nanoseconds.
+     */
+    int64_t observe(const std::size_t device, const IImage& image, const uint64_t received_ns);
+
+    /**
+     * @brief Gets the planned bursts together with the measurements so far.
+     * @return std::vector<Burst>
+     */
+    [[nodiscard]] std::vector<Burst> report() const;
+
+    /**
+     * @brief Gets the planned time from the trigger until every burst has been received.
+     * @return int64_t in nanoseconds
+     */
+    [[nodiscard]] int64_t latency() const;
+
+   private:
+    std::vector<std::shared_ptr<IDevice>> devices_;
+    Options                               options_;
+
+    mutable std::mutex mutex_;
+    std::vector<Burst> bursts_;
+};
+
+}  // namespace lucid
+}  // namespace camera
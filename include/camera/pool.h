@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Recycles image buffers of similar size, so that steady streaming does not allocate per frame.
+ *      Buffers are returned to the pool when the last `camera::IImage` referring to them is destroyed.
+ *      Sizes are rounded up to size classes, 8 per doubling, so that frames whose size varies slightly share buffers.
+ *      Sizes known in advance, such as those of full frames, may be given as classes of their own, so that their
+ *      buffers waste nothing for rounding.
+ * @note pools must be owned by `std::shared_ptr`, since every acquired buffer keeps its pool alive.
+ */
+class BufferPool: public std::enable_shared_from_this<BufferPool> {
+   public:
+    /**
+     * @param max_cached_bytes [in] Upper bound of idle memory kept for reuse. Surplus buffers are freed.
+     * @param exact_sizes [in] Sizes used as classes of their own, by every size that would otherwise be rounded past
+     *      them.
+     */
+    explicit BufferPool(const std::size_t max_cached_bytes = 256UL << 20, std::vector<std::size_t> exact_sizes = {});
+    ~BufferPool();
+
+    BufferPool(const BufferPool&)            = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Takes an idle buffer of at least the given size, or allocates a new one if there is none.
+     * @param size [in] Number of bytes.
+     * @return Buffer
+     */
+    [[nodiscard]] Buffer acquire(const std::size_t size);
+
+    /**
+     * @brief Hands a buffer back to the pool. Called by `camera::BufferDeleter`, with the capacity of the buffer.
+     */
+    void recycle(uint8_t* ptr, const std::size_t size);
+
+    /**
+     * @brief Frees every idle buffer.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the amount of idle memory kept for reuse.
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t cachedBytes() const;
+
+   private:
+    std::size_t sizeClassOf_(const std::size_t size) const;
+
+    std::vector<std::size_t> exact_sizes_;  // ascending
+
+    mutable std::mutex                                     mutex_;
+    std::unordered_map<std::size_t, std::vector<uint8_t*>> idle_;
+    std::size_t                                            cached_bytes_     = 0;
+    std::size_t                                            max_cached_bytes_ = 0;
+};
+
+}  // namespace camera
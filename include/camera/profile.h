@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "camera/device.h"
+
+namespace camera {
+namespace profile {
+
+/**
+ * @brief Serializes the parameters into text, one `name=value` line per parameter.
+ *      The text of equal parameters is always the same, so it can be hashed.
+ *
+ * @param param
+ * @return std::string
+ */
+std::string serialize(const DeviceParameters& param);
+
+/**
+ * @brief Parses parameters serialized by `profile::serialize()`. Parameters missing from the text keep their default
+ * value, and lines starting with '#' are ignored.
+ *
+ * @param text
+ * @return DeviceParameters
+ * @throw camera::exception::InvalidConfigValue if a line names an unknown parameter or holds an invalid value.
+ */
+DeviceParameters parse(const std::string& text);
+
+/**
+ * @brief Gets the 64-bit FNV-1a hash of the serialized parameters.
+ *
+ * @param param
+ * @return uint64_t
+ */
+uint64_t hashOf(const DeviceParameters& param);
+
+/**
+ * @brief Writes the parameters to a file, headed by their hash.
+ *
+ * @param path
+ * @param param
+ * @throw camera::exception::GenericException if the file cannot be written.
+ */
+void save(const std::filesystem::path& path, const DeviceParameters& param);
+
+/**
+ * @brief Reads parameters written by `profile::save()`.
+ *
+ * @param path
+ * @return DeviceParameters
+ * @throw camera::exception::GenericException if the file cannot be read.
+ * @throw camera::exception::InvalidConfigValue if the file holds invalid parameters.
+ */
+DeviceParameters load(const std::filesystem::path& path);
+
+}  // namespace profile
+}  // namespace camera
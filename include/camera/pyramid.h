@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "camera/image.h"
+#include "camera/pool.h"
+
+namespace camera {
+
+/**
+ * @brief Builds 1/2, 1/4, 1/8, ... scale levels of a frame and attaches them to `IImage::levels`.
+ *      All levels are produced in a single pass over the source: every finer row is consumed by the next level right
+ *      after it is written, while it is still in cache. Rows are reduced 2x2 with SSE2/NEON where available, in every
+ *      supported format.
+ *
+ * @details
+ * `PixelFormat::MONO8`, `PixelFormat::RGB8` and `PixelFormat::BGR8` keep their format on every level.
+ * `PixelFormat::BAYER_RG8` is demosaiced by its 2x2 quads, so that its first level is an RGB8 image of a quarter of
+ * the pixels.
+ * every level keeps the 16-bit sums of the source pixels it covers, and coarser levels are added up from those sums, so
+ * that each pixel is the mean of its source pixels, rounded once. the sums of the levels past 1/16 would not fit, so
+ * those levels average the sums instead, which keeps 8 bits below the pixel value and may put a pixel one off the
+ * exactly rounded mean.
+ *
+ * @note
+ * level buffers are taken from a `camera::BufferPool`, and return to it when the frame is released.
+ * an instance keeps scratch rows, so it must not be used by several threads at once.
+ */
+class Pyramid {
+   public:
+    /**
+     * @param num_levels [in] Number of levels to build, where level `i` is scaled by `1 / 2^(i + 1)`.
+     * @param pool [in] Pool to take level buffers from. A private pool is created if it is null.
+     */
+    explicit Pyramid(const std::size_t num_levels = 3, std::shared_ptr<BufferPool> pool = nullptr);
+
+    /**
+     * @brief Builds the levels of the frame and attaches them, replacing previously attached levels.
+     * @param image [in/out]
+     * @throw camera::exception::InvalidConfigValue if the pixel format is not supported.
+     */
+    void process(IImage& image);
+
+   private:
+    std::size_t                        num_levels_ = 3;
+    std::shared_ptr<BufferPool>        pool_       = nullptr;
+    std::vector<uint16_t>              wide_;  // sums of a row pair, before adding the horizontal pairs
+    std::vector<std::vector<uint16_t>> sums_;  // sums of the pixels of the latest even and odd row of every level
+};
+
+}  // namespace camera
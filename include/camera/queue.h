@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace camera {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *      Neither side ever blocks nor allocates; `SpscQueue::push()` fails instead when the queue is full.
+ */
+template <typename T>
+class SpscQueue {
+   public:
+    /**
+     * @param capacity [in] Number of elements the queue holds, rounded up to a power of two.
+     */
+    explicit SpscQueue(const std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_  = size - 1;
+        slots_ = std::make_unique<std::optional<T>[]>(size);
+    }
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Appends an element. Called by the producer only.
+     * @param value [in]
+     * @return false if the queue is full, in which case the value is left untouched.
+     */
+    bool push(T&& value) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        slots_[tail & mask_].emplace(std::move(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest element. Called by the consumer only.
+     * @param value [out]
+     * @return false if the queue is empty.
+     */
+    bool pop(T& value) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto& slot = slots_[head & mask_];
+        value      = std::move(*slot);
+        slot.reset();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of queued elements, which may be outdated by the time it returns.
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t size() const {
+        return static_cast<std::size_t>(tail_.load(std::memory_order_acquire)
+                                        - head_.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+   private:
+    std::size_t                         mask_ = 0;
+    std::unique_ptr<std::optional<T>[]> slots_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};  // advanced by the consumer
+    alignas(64) std::atomic<uint64_t> tail_{0};  // advanced by the producer
+};
+
+}  // namespace camera
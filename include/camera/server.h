@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "camera/image.h"
+
+namespace camera {
+
+/**
+ * @brief Wire format shared by `camera::FrameServer` and `camera::FrameClient`.
+ *
+ * @details
+ * the server sends one `FrameMessage` per frame over a `SOCK_SEQPACKET` unix-domain socket, together with a read-only
+ * descriptor of the memfd holding the image data passed by `SCM_RIGHTS`. the memfds form a ring of slots which the
+ * server reuses, and which are sealed against shrinking, so that a mapping of the client stays valid.
+ * the client grants credits by sending `CreditMessage`s; the server sends a frame to a client only while it holds
+ * credits, and drops the frame for that client otherwise. a client returns the credit of a frame, with its slot, once
+ * it is done with the frame, and the server only reuses a slot which no client holds.
+ */
+namespace wire {
+
+constexpr uint32_t kFrameMagic  = 0x4D52464CU;  // "LFRM"
+constexpr uint32_t kCreditMagic = 0x4452434CU;  // "LCRD"
+constexpr uint32_t kVersion     = 2U;
+constexpr uint32_t kNoSlot      = 0xFFFFFFFFU;  // credits granted up front, which release no slot
+
+struct FrameMessage {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t stamp;
+    uint64_t seq;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t step;
+    uint64_t depth;
+    uint64_t size;
+    uint32_t complete;
+    uint32_t slot;
+};
+
+struct CreditMessage {
+    uint32_t magic;
+    uint32_t credits;
+    uint32_t slot;  // released by the client, or `kNoSlot`
+};
+
+}  // namespace wire
+
+/**
+ * @brief Publishes the frames of a device to local subscribers over a unix-domain socket.
+ *      Each subscriber is flow-controlled by its own credits, so a slow subscriber only drops frames for itself and
+ *      never stalls `FrameServer::publish()` nor the other subscribers.
+ *      A frame is copied once, into a reusable shared memory slot, and subscribers map the slot instead of copying it.
+ *      Frames are dropped for every subscriber while all slots are held by subscribers.
+ */
+class FrameServer {
+   public:
+    struct Subscriber {
+        int      id      = -1;
+        int64_t  credits = 0;
+        uint64_t sent    = 0;
+        uint64_t dropped = 0;
+    };
+
+    /**
+     * @param path [in] Filesystem path of the socket. An existing socket file on the path is replaced.
+     * @param max_subscribers [in]
+     * @param num_slots [in] Number of shared memory slots frames are published through.
+     */
+    explicit FrameServer(const std::string& path, const std::size_t max_subscribers = 16,
+                         const std::size_t num_slots = 8);
+    ~FrameServer();
+
+    FrameServer(const FrameServer&)            = delete;
+    FrameServer& operator=(const FrameServer&) = delete;
+
+    /**
+     * @brief Sends the frame to every subscriber holding credits. It never blocks on subscribers, and the frame is
+     *      copied without holding the lock of the subscribers.
+     * @param image [in]
+     * @return Number of subscribers the frame was delivered to.
+     */
+    std::size_t publish(const IImage& image);
+
+    /**
+     * @brief Gets a snapshot of the connected subscribers.
+     * @return std::vector<Subscriber>
+     */
+    [[nodiscard]] std::vector<Subscriber> subscribers() const;
+
+    [[nodiscard]] const std::string& path() const { return path_; }
+
+   private:
+    struct Slot {
+        int              fd       = -1;  // writable, kept by the server
+        int              read_fd  = -1;  // read-only, sent to subscribers
+        uint8_t*         data     = nullptr;
+        std::size_t      capacity = 0;
+        bool             writing  = false;
+        std::vector<int> holders;  // subscribers which have not released the frame in the slot yet
+    };
+
+    void run_();
+    void accept_();
+    void receive_(Subscriber& subscriber);
+    void close_(Subscriber& subscriber);
+    void reserve_(Slot& slot, const std::size_t size);
+
+    std::string path_;
+    std::size_t max_subscribers_ = 0;
+    int         listen_fd_       = -1;
+    int         wakeup_fd_       = -1;
+
+    mutable std::mutex      mutex_;
+    std::vector<Subscriber> subscribers_;
+    std::vector<Slot>       slots_;
+    std::size_t             next_slot_ = 0;
+
+    std::atomic<bool> stop_requested_;
+    std::thread       worker_;
+};
+
+/**
+ * @brief Receives frames published by `camera::FrameServer`.
+ */
+class FrameClient {
+   public:
+    /**
+     * @param path [in] Filesystem path of the server socket.
+     * @param credits [in] Number of frames the server may send ahead of `FrameClient::receive()`.
+     */
+    explicit FrameClient(const std::string& path, const uint32_t credits = 2);
+    ~FrameClient();
+
+    FrameClient(const FrameClient&)            = delete;
+    FrameClient& operator=(const FrameClient&) = delete;
+
+    /**
+     * @brief Waits for the next frame. The frame is a read-only view of the shared memory of the server, and its
+     *      credit is granted back to the server once the frame is released, which may outlive the client.
+     * @param timeout_ms [in]
+     * @return std::shared_ptr<IImage>
+     * @throw camera::exception::Timeout if no frame arrives within the timeout.
+     */
+    [[nodiscard]] std::shared_ptr<IImage> receive(const int64_t timeout_ms = 1000);
+
+   private:
+    class Connection;
+
+    std::shared_ptr<Connection> connection_;  // shared with the frames received
+};
+
+}  // namespace camera
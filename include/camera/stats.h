@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace camera {
+
+/**
+ * @brief Snapshot of the streaming health of a device. Counters accumulate since the device was created, across
+ *      restarts of its stream.
+ */
+struct DeviceStats {
+    double   fps              = 0.0;  // frames delivered per second, over the latest sampling period
+    double   bytes_per_second = 0.0;  // image bytes delivered per second, over the latest sampling period
+    uint64_t frames           = 0;    // frames delivered by `IDevice::capture()`
+    uint64_t bytes            = 0;    // image bytes delivered by `IDevice::capture()`
+    uint64_t incomplete       = 0;    // frames delivered with missing data
+    uint64_t lost_frames      = 0;    // reported by the stream
+    uint64_t missed_packets   = 0;    // reported by the stream
+    uint64_t resend_requests  = 0;    // reported by the stream
+    uint64_t underruns        = 0;    // captures which found no frame before their timeout
+    int64_t  wait_ns          = 0;    // time captures spent blocked waiting for a frame
+    int64_t  copy_ns          = 0;    // time captures spent copying frames out of the stream buffers
+};
+
+/**
+ * @brief Maintains `DeviceStats` from the capture path.
+ *      Every capture only adds to atomic counters. The counters of the stream, which are kept by the host, are sampled
+ *      by the capture thread at a fixed cadence together with the rates, so reading a snapshot never touches the
+ *      stream.
+ *
+ * @details
+ * captures are recorded by a single thread at a time, whereas snapshots may be taken from any thread.
+ * captures which time out sample as well, so the rates drop to zero with the frames. without any capture, they drop
+ * to zero after two sampling periods.
+ */
+class StatsRecorder {
+   public:
+    struct StreamCounters {
+        int64_t lost_frames     = 0;
+        int64_t missed_packets  = 0;
+        int64_t resend_requests = 0;
+    };
+
+    /**
+     * @brief Reads the cumulative counters of the current stream. Returns false if they could not be read.
+     */
+    using StreamSampler = std::function<bool(StreamCounters& counters)>;
+
+    /**
+     * @param interval_ns [in] Sampling period of the rates and of the stream counters.
+     */
+    explicit StatsRecorder(const int64_t interval_ns = 1'000'000'000);
+
+    StatsRecorder(const StatsRecorder&)            = delete;
+    StatsRecorder& operator=(const StatsRecorder&) = delete;
+
+    /**
+     * @brief Sets how the counters of the stream are read. It must be set while nothing is recorded.
+     * @param sampler [in] null disables the stream counters.
+     */
+    void setStreamSampler(StreamSampler sampler);
+
+    /**
+     * @brief Records a frame delivered by a capture, and samples if the period has elapsed.
+     * @param bytes [in] Size of the image data.
+     * @param complete [in]
+     * @param wait_ns [in] Time blocked waiting for the frame.
+     * @param copy_ns [in] Time spent copying the frame.
+     */
+    void frame(const uint64_t bytes, const bool complete, const int64_t wait_ns, const int64_t copy_ns);
+
+    /**
+     * @brief Records a capture which found no frame before its timeout, and samples if the period has elapsed.
+     * @param wait_ns [in] Time blocked waiting.
+     */
+    void underrun(const int64_t wait_ns);
+
+    /**
+     * @brief Keeps the stream counters sampled so far, before they restart with a new stream.
+     */
+    void restart();
+
+    /**
+     * @brief Gets the statistics recorded so far.
+     * @return DeviceStats
+     */
+    [[nodiscard]] DeviceStats snapshot() const;
+
+   private:
+    void tick_();
+    void sample_(const int64_t now_ns);
+
+    int64_t       interval_ns_;
+    StreamSampler sampler_ = nullptr;
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> incomplete_{0};
+    std::atomic<uint64_t> underruns_{0};
+    std::atomic<int64_t>  wait_ns_{0};
+    std::atomic<int64_t>  copy_ns_{0};
+
+    // sampled
+    std::atomic<int64_t>  sampled_ns_{0};  // steady time of the latest sample
+    std::atomic<uint64_t> sampled_frames_{0};
+    std::atomic<uint64_t> sampled_bytes_{0};
+    std::atomic<double>   fps_{0.0};
+    std::atomic<double>   bytes_per_second_{0.0};
+
+    // counters of the current stream, and of the streams before it
+    std::atomic<int64_t> lost_frames_{0};
+    std::atomic<int64_t> missed_packets_{0};
+    std::atomic<int64_t> resend_requests_{0};
+    std::atomic<int64_t> past_lost_frames_{0};
+    std::atomic<int64_t> past_missed_packets_{0};
+    std::atomic<int64_t> past_resend_requests_{0};
+};
+
+}  // namespace camera
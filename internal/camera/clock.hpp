@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace camera {
+
+/**
+ * @brief Gets the time of the host monotonic clock, `CLOCK_MONOTONIC` on Linux, in nanoseconds.
+ *      Every duration and host stamp of the library is taken from this clock, so they can be compared to each other.
+ */
+inline int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace camera
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "camera/exception.h"
+#include "camera/lucid/device.hpp"
+#include "camera/lucid/spec.hpp"
+#include "camera/lucid/types.h"
+
+namespace camera {
+namespace lucid {
+
+/**
+ * @brief Device specialized for a model, whose setup is selected at compile time from `SpecOf<M>`.
+ *      Parameters which only exist on some models are applied here, and captured images are decoded only into the
+ *      pixel formats the model streams, so the common device never branches on the type of its model.
+ */
+template<Model M>
+class DeviceOf final : public Device {
+   public:
+    using ModelSpec = SpecOf<M>;
+
+    using Device::Device;
+
+    ~DeviceOf() override { stopWatching_(); }
+
+   protected:
+    void applyModelParams_(Config& config, const DeviceParameters& param) override {
+        if constexpr (ModelSpec::device_type == DeviceType::RGB_CAMERA) {
+            // the parameters were accepted once set, so they are not read back from the device
+            config.setExposureAuto(param.exposure_auto);
+            if (param.exposure_auto == AutoMode::CONTINUOUS) {
+                config.setExposureAutoLimitAuto(param.exposure_auto_limit_auto);
+                if (param.exposure_auto_limit_auto == AutoMode::OFF) {
+                    config.setExposureAutoLowerLimit(param.exposure_auto_lower_limit);
+                    config.setExposureAutoUpperLimit(param.exposure_auto_upper_limit);
+                }
+            } else {
+                config.setExposureTime(param.exposure_time);
+            }
+
+            config.setReverseX(param.reverse_x);
+            config.setReverseY(param.reverse_y);
+
+            config.setTargetBrightness(param.target_brightness);
+            config.setTransferOperationMode(param.transfer_operation_mode);
+        } else if constexpr (ModelSpec::device_type == DeviceType::TOF_CAMERA) {
+            config.setScan3dModeSelector("Processed");
+            config.setConversionGain(param.conversion_gain);
+        }
+    }
+
+    PixelFormat pixelFormatOf_(const uint64_t pfnc) const override {
+        switch (pfnc) {
+        case Mono8:
+            if constexpr (ModelSpec::streams(format::MONO8)) {
+                return PixelFormat::MONO8;
+            }
+            break;
+        case Mono16:
+            if constexpr (ModelSpec::streams(format::MONO16)) {
+                return PixelFormat::MONO16;
+            }
+            break;
+        case BayerRG8:
+            if constexpr (ModelSpec::streams(format::BAYER_RG8)) {
+                return PixelFormat::BAYER_RG8;
+            }
+            break;
+        case BayerRG16:
+            if constexpr (ModelSpec::streams(format::BAYER_RG16)) {
+                return PixelFormat::BAYER_RG16;
+            }
+            break;
+        case RGB8:
+            if constexpr (ModelSpec::streams(format::RGB8)) {
+                return PixelFormat::RGB8;
+            }
+            break;
+        case BGR8:
+            if constexpr (ModelSpec::streams(format::BGR8)) {
+                return PixelFormat::BGR8;
+            }
+            break;
+        default:
+            break;
+        }
+        return PixelFormat::UNKNOWN;  // such as the 3D formats of time of flight cameras, which have no counterpart
+    }
+
+    void startTransfer_(Arena::IDevice* device) override {
+        if constexpr (ModelSpec::device_type == DeviceType::RGB_CAMERA) {
+            Arena::ExecuteNode(device->GetNodeMap(), "TransferStart");
+        }
+    }
+
+    void stopTransfer_(Arena::IDevice* device) override {
+        if constexpr (ModelSpec::device_type == DeviceType::RGB_CAMERA) {
+            Arena::ExecuteNode(device->GetNodeMap(), "TransferStop");
+        }
+    }
+};
+
+/**
+ * @brief Creates the device specialized for a model.
+ * @param model [in]
+ * @param args [in] Arguments of the `Device` constructor.
+ * @return std::shared_ptr<Device>
+ * @throw camera::exception::UnknownModel if the model is not supported.
+ */
+template<typename... Args>
+std::shared_ptr<Device> makeDevice(const Model model, Args&&... args) {
+    switch (model) {
+    case Model::TRI028S_C:
+        return std::make_shared<DeviceOf<Model::TRI028S_C>>(std::forward<Args>(args)...);
+    case Model::PHX016S_C:
+        return std::make_shared<DeviceOf<Model::PHX016S_C>>(std::forward<Args>(args)...);
+    case Model::HTP003S_001:
+        return std::make_shared<DeviceOf<Model::HTP003S_001>>(std::forward<Args>(args)...);
+    default:
+        throw exception::UnknownModel();
+    }
+}
+
+}  // namespace lucid
+}  // namespace camera
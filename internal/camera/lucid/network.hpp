@@ -2,19 +2,143 @@
 
 #include <ArenaApi.h>
 
+#include <camera/device.h>
 #include <camera/exception.h>
 
+#include <camera/lucid/config.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace camera {
 namespace lucid {
 namespace network {
 
+/**
+ * @brief Address of a device on the subnet of a host interface.
+ */
+struct Assignment {
+    uint64_t mac         = 0;
+    uint32_t ip_address  = 0;      // current address of the device, or the planned one if `forced`
+    uint32_t subnet_mask = 0;
+    bool     forced      = false;  // whether the address has to be forced on the device
+};
+
+/**
+ * @brief Plans the addresses of devices on the subnet of a host interface.
+ * Devices already on the subnet keep their address, unless it collides with the host or with another device. Every
+ * other device is assigned an address derived from its MAC, probing upwards while the address is taken, so the same
+ * devices are assigned the same addresses on every run.
+ *
+ * @param host_address
+ * @param subnet_mask
+ * @param devices Current addresses of the devices.
+ * @param reserved Addresses taken by devices of other interfaces.
+ * @return Planned addresses, in the order of the devices.
+ * @throw camera::exception::InvalidConfigValue if the subnet cannot hold every device.
+ */
+std::vector<Assignment> planAddresses(const uint32_t host_address, const uint32_t subnet_mask,
+                                      const std::vector<Assignment>& devices,
+                                      const std::vector<uint32_t>&   reserved = {});
+
+/**
+ * @brief Devices reached through a host interface.
+ */
+struct Subnet {
+    uint32_t                host_address = 0;
+    uint32_t                subnet_mask  = 0;
+    std::vector<Assignment> devices;
+};
+
+/**
+ * @brief Plans the addresses of the devices of several host interfaces, whose subnets may overlap.
+ * Every interface is planned by `network::planAddresses()`, avoiding the hosts, the addresses planned for the
+ * interfaces before it, and the addresses the devices of the interfaces after it keep. A device therefore keeps its
+ * address unless it collides within its own interface, or with a device kept by an interface planned later.
+ *
+ * @param subnets
+ * @return Planned addresses, interface after interface in the order of the subnets.
+ * @throw camera::exception::InvalidConfigValue if a subnet cannot hold its devices.
+ */
+std::vector<Assignment> planSubnets(const std::vector<Subnet>& subnets);
+
 /**
  * @brief Configures ip address and subnet mask of the discovered entire devices.
+ * Devices are grouped by the host interface they are reached through, and the addresses of each group are planned by
+ * `network::planSubnets()` on the subnet of its own interface. Every device which needs a new address is then forced,
+ * one after another across all interfaces.
  *
  * @param system
+ * @throw camera::exception::GenericException with the first failure, once every device has been forced.
  */
 void autoConfigureIP(Arena::ISystem* sys, std::vector<Arena::DeviceInfo>& device_infos);
 
+/**
+ * @brief Gets the address of the host interface through which the device is reached.
+ *
+ * @param sys
+ * @param device_info
+ * @return Empty if the interface is unknown.
+ */
+std::string hostAddressOf(Arena::ISystem* sys, const Arena::DeviceInfo& device_info);
+
+/**
+ * @brief Gets the access status of the device as its host interface reports it, without opening the device.
+ * ReadWrite means that nobody controls the device, and that opening it would take control, whereas ReadOnly means
+ * that another host controls it.
+ *
+ * @param sys
+ * @param device_info
+ * @return Empty if the status cannot be read.
+ */
+std::string accessStatusOf(Arena::ISystem* sys, const Arena::DeviceInfo& device_info);
+
+/**
+ * @brief Gets the MTU of the host interface holding the address.
+ *
+ * @param host_ipv4
+ * @return 0 if no interface holds the address.
+ */
+int64_t hostMtuOf(const std::string& host_ipv4);
+
+/**
+ * @brief Gets the number of bytes an image occupies on the wire, including the GVSP, UDP, IP and Ethernet framing of
+ * every packet.
+ *
+ * @param payload_bytes
+ * @param packet_size GevSCPSPacketSize, which counts the IP, UDP and GVSP headers.
+ * @return int64_t
+ */
+int64_t wireBytesOf(const int64_t payload_bytes, const int64_t packet_size);
+
+/**
+ * @brief Gets the number of packets an image is sent in, including the GVSP leader and trailer.
+ *
+ * @param payload_bytes
+ * @param packet_size GevSCPSPacketSize, which counts the IP, UDP and GVSP headers.
+ * @return int64_t
+ */
+int64_t packetsOf(const int64_t payload_bytes, const int64_t packet_size);
+
+/**
+ * @brief Gets the number of bytes a single packet occupies on the wire.
+ *
+ * @param packet_size GevSCPSPacketSize, which counts the IP, UDP and GVSP headers.
+ * @return int64_t
+ */
+int64_t wirePacketBytesOf(const int64_t packet_size);
+
+/**
+ * @brief Gets the speed of the link of a device in bytes per second, or the nominal speed of its model if the device
+ * does not report it.
+ *
+ * @param config
+ * @param info
+ * @return 0 if neither the device nor its model tell the speed.
+ */
+int64_t linkSpeedOf(const Config& config, const DeviceInfo& info);
+
 }  // namespace network
 }  // namespace lucid
 }  // namespace camera
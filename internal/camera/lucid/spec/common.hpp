@@ -1,20 +1,42 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include "camera/lucid/spec.h"
 #include "camera/lucid/types.h"
 
 namespace camera {
 namespace lucid {
 
+/**
+ * @brief Limits of a model at compile time, taken from `kSpecs`, so that the runtime and the compile-time view of a
+ *      model cannot disagree.
+ */
+template<Model M>
+struct SpecBase {
+    static constexpr Spec        spec               = specOf(M);
+    static constexpr DeviceType  device_type        = spec.device_type;
+    static constexpr std::size_t max_rate           = spec.max_rate;
+    static constexpr std::size_t max_width          = spec.max_width;
+    static constexpr std::size_t max_height         = spec.max_height;
+    static constexpr uint32_t    pixel_formats      = spec.pixel_formats;
+    static constexpr std::size_t max_bits_per_pixel = spec.max_bits_per_pixel;
+    static constexpr std::size_t max_payload_bytes  = spec.max_payload_bytes;
+    static constexpr std::size_t sensor_bit_depth   = spec.sensor_bit_depth;
+    static constexpr int64_t     link_speed         = spec.link_speed;
+
+    /**
+     * @brief Whether the model can stream a pixel format, given as a bit of `format`.
+     */
+    static constexpr bool streams(const uint32_t format_bit) { return (pixel_formats & format_bit) != 0; }
+};
+
 template<Model M>
 struct SpecOf {};
 
 template<>
-struct SpecOf<Model::UNKNOWN> {
-    static constexpr DeviceType  device_type = DeviceType::UNDEFINED;
-    static constexpr std::size_t max_rate    = 0;
-    static constexpr std::size_t max_width   = 0;
-    static constexpr std::size_t max_height  = 0;
-};
+struct SpecOf<Model::UNKNOWN>: SpecBase<Model::UNKNOWN> {};
 
 }  // namespace lucid
 }  // namespace camera
@@ -8,12 +8,7 @@ namespace camera {
 namespace lucid {
 
 template<>
-struct SpecOf<Model::HTP003S_001> {
-    static constexpr DeviceType  device_type = DeviceType::TOF_CAMERA;
-    static constexpr std::size_t max_rate    = 103;
-    static constexpr std::size_t max_width   = 640;
-    static constexpr std::size_t max_height  = 480;
-};
+struct SpecOf<Model::HTP003S_001>: SpecBase<Model::HTP003S_001> {};
 
 }  // namespace lucid
 }  // namespace camera
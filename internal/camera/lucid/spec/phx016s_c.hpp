@@ -8,12 +8,7 @@ namespace camera {
 namespace lucid {
 
 template<>
-struct SpecOf<Model::PHX016S_C> {
-    static constexpr DeviceType  device_type = DeviceType::RGB_CAMERA;
-    static constexpr std::size_t max_rate    = 71;
-    static constexpr std::size_t max_width   = 1440;
-    static constexpr std::size_t max_height  = 1080;
-};
+struct SpecOf<Model::PHX016S_C>: SpecBase<Model::PHX016S_C> {};
 
 }  // namespace lucid
 }  // namespace camera
@@ -8,12 +8,7 @@ namespace camera {
 namespace lucid {
 
 template<>
-struct SpecOf<Model::TRI028S_C> {
-    static constexpr DeviceType  device_type = DeviceType::RGB_CAMERA;
-    static constexpr std::size_t max_rate    = 39;
-    static constexpr std::size_t max_width   = 1936;
-    static constexpr std::size_t max_height  = 1464;
-};
+struct SpecOf<Model::TRI028S_C>: SpecBase<Model::TRI028S_C> {};
 
 }  // namespace lucid
 }  // namespace camera
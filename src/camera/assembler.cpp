@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <chrono>
+
+#include "camera/assembler.h"
+#include "camera/clock.hpp"
+#include "camera/exception.h"
+
+namespace camera {
+
+namespace {
+constexpr auto kPollInterval = std::chrono::milliseconds(1);
+}  // namespace
+
+FrameSetAssembler::FrameSetAssembler(const Options& options, Callback callback)
+    : options_(options)
+    , callback_(std::move(callback)) {
+    if (options_.num_devices == 0 || options_.queue_capacity == 0) {
+        throw exception::InvalidConfigValue("frame set assembler requires devices and queue capacity");
+    }
+    if (options_.mode == Mode::ACTION_EPOCH && options_.epoch_period_ns == 0) {
+        throw exception::InvalidConfigValue("action epoch matching requires the period of action commands");
+    }
+    if (!options_.offsets_ns.empty() && options_.offsets_ns.size() != options_.num_devices) {
+        throw exception::InvalidConfigValue("stamp offsets must be given for every device");
+    }
+    options_.offsets_ns.resize(options_.num_devices, 0);
+
+    for (std::size_t i = 0; i < options_.num_devices; i++) {
+        queues_.emplace_back(std::make_unique<SpscQueue<std::shared_ptr<const IImage>>>(options_.queue_capacity));
+    }
+    worker_ = std::thread(&FrameSetAssembler::run_, this);
+}
+
+FrameSetAssembler::~FrameSetAssembler() {
+    {
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        stop_requested_.store(true);
+    }
+    wakeup_cv_.notify_one();
+    worker_.join();
+}
+
+bool FrameSetAssembler::push(const std::size_t device, std::shared_ptr<const IImage> image) {
+    if (device >= queues_.size()) {
+        throw exception::InvalidConfigValue("device index out of range: " + std::to_string(device));
+    }
+    if (image == nullptr) {
+        return false;
+    }
+    if (!queues_[device]->push(std::move(image))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+    wakeup_cv_.notify_one();  // a missed notification only delays matching by the poll interval
+    return true;
+}
+
+FrameSetAssembler::Stats FrameSetAssembler::stats() const {
+    Stats stats;
+    stats.complete = complete_.load(std::memory_order_relaxed);
+    stats.partial  = partial_.load(std::memory_order_relaxed);
+    stats.dropped  = dropped_.load(std::memory_order_relaxed);
+    stats.late     = late_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64_t FrameSetAssembler::keyOf_(const std::size_t device, const IImage& image) const {
+    const auto stamp = static_cast<uint64_t>(static_cast<int64_t>(image.header.stamp) - options_.offsets_ns[device]);
+    if (options_.mode == Mode::TIMESTAMP) {
+        return stamp;
+    }
+    const auto half = options_.epoch_period_ns / 2;
+    if (stamp + half < options_.epoch_origin_ns) {
+        return 0;
+    }
+    return (stamp + half - options_.epoch_origin_ns) / options_.epoch_period_ns;
+}
+
+void FrameSetAssembler::match_(const std::size_t device, std::shared_ptr<const IImage> image) {
+    const auto key       = keyOf_(device, *image);
+    const auto tolerance = (options_.mode == Mode::TIMESTAMP) ? options_.tolerance_ns : 0;
+
+    // frames of a delivered set, which are at most `tolerance` past its key
+    if (has_delivered_ && key <= last_key_ + tolerance) {
+        late_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // a set spans the keys of all its frames, which must stay within `tolerance` of each other
+    const auto fits = [&](const Pending& pending) {
+        return pending.set.frames[device] == nullptr &&
+               std::max(key, pending.max_key) - std::min(key, pending.set.key) <= tolerance;
+    };
+    auto found = pending_.begin();
+    for (; found != pending_.end(); ++found) {
+        if (key + tolerance < found->set.key) {
+            break;  // sets are ordered, so no later set can match either
+        }
+        if (fits(*found)) {
+            break;
+        }
+    }
+    if (found == pending_.end() || !fits(*found)) {
+        Pending pending;
+        pending.set.key = key;
+        pending.set.frames.resize(options_.num_devices);
+        pending.max_key   = key;
+        pending.opened_ns = static_cast<uint64_t>(steadyNs());
+        found             = pending_.insert(found, std::move(pending));
+    }
+
+    found->set.key            = std::min(found->set.key, key);
+    found->max_key            = std::max(found->max_key, key);
+    found->set.frames[device] = std::move(image);
+    found->set.count++;
+    if (found->set.complete()) {
+        deliver_(static_cast<std::size_t>(found - pending_.begin()) + 1);
+    }
+}
+
+void FrameSetAssembler::expire_(const uint64_t now) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < pending_.size(); i++) {
+        if (pending_[i].opened_ns + options_.deadline_ns <= now) {
+            count = i + 1;
+        }
+    }
+    if (count > 0) {
+        deliver_(count);
+    }
+}
+
+void FrameSetAssembler::deliver_(const std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        FrameSet set = std::move(pending_.front().set);
+        pending_.pop_front();
+
+        (set.complete() ? complete_ : partial_).fetch_add(1, std::memory_order_relaxed);
+        has_delivered_ = true;
+        last_key_      = set.key;
+        if (callback_) {
+            callback_(std::move(set));
+        }
+    }
+}
+
+void FrameSetAssembler::run_() {
+    std::shared_ptr<const IImage> image;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeup_mutex_);
+            wakeup_cv_.wait_for(lock, kPollInterval, [this]() {
+                return stop_requested_.load() || queued_.load(std::memory_order_acquire) > 0;
+            });
+        }
+        const bool is_stopping = stop_requested_.load();
+
+        for (std::size_t device = 0; device < queues_.size(); device++) {
+            while (queues_[device]->pop(image)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                match_(device, std::move(image));
+            }
+        }
+
+        if (is_stopping) {
+            deliver_(pending_.size());
+            return;
+        }
+        expire_(static_cast<uint64_t>(steadyNs()));
+    }
+}
+
+}  // namespace camera
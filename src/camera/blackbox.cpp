@@ -0,0 +1,178 @@
+#include <fstream>
+
+#include "camera/blackbox.h"
+#include "camera/exception.h"
+
+namespace camera {
+
+namespace {
+std::size_t sizeOf(const IImage& image) {
+    return image.step * image.rows;
+}
+
+uint64_t windowBegin(const BlackBox::Window& window) {
+    return (window.event_stamp > window.before_ns) ? (window.event_stamp - window.before_ns) : 0;
+}
+
+uint64_t windowEnd(const BlackBox::Window& window) {
+    return window.event_stamp + window.after_ns;
+}
+}  // namespace
+
+BlackBox::BlackBox(const Capacity& capacity, const std::filesystem::path& directory, const std::string& prefix)
+    : capacity_(capacity)
+    , directory_(directory)
+    , prefix_(prefix) {
+    writer_ = std::thread(&BlackBox::run_, this);
+}
+
+BlackBox::~BlackBox() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& job : pending_) {
+            dispatch_(std::move(job));  // writes whatever has been collected so far
+        }
+        pending_.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        stop_requested_ = true;
+    }
+    writer_cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void BlackBox::push(const std::shared_ptr<const IImage>& image) {
+    if (image == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.push_back(image);
+    ring_bytes_ += sizeOf(*image);
+    evict_();
+
+    const auto stamp = image->header.stamp;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (stamp >= windowBegin(it->window) && stamp <= windowEnd(it->window)) {
+            it->frames.push_back(image);
+        }
+        if (stamp >= windowEnd(it->window)) {
+            dispatch_(std::move(*it));
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::future<std::filesystem::path> BlackBox::flush(const Window& window) {
+    Job  job;
+    auto result = job.promise.get_future();
+    job.window  = window;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& image : ring_) {
+        const auto stamp = image->header.stamp;
+        if (stamp >= windowBegin(window) && stamp <= windowEnd(window)) {
+            job.frames.push_back(image);
+        }
+    }
+
+    const bool is_complete = (!ring_.empty() && ring_.back()->header.stamp >= windowEnd(window));
+    if (is_complete) {
+        dispatch_(std::move(job));
+    } else {
+        pending_.emplace_back(std::move(job));
+    }
+    return result;
+}
+
+std::size_t BlackBox::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.size();
+}
+
+std::size_t BlackBox::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_bytes_;
+}
+
+void BlackBox::evict_() {
+    while (ring_.size() > 1) {
+        const auto& oldest = ring_.front();
+        const auto& newest = ring_.back();
+
+        const bool exceeds_duration = (capacity_.duration_ns > 0)
+                                   && (newest->header.stamp - oldest->header.stamp > capacity_.duration_ns);
+        const bool exceeds_bytes = (capacity_.bytes > 0) && (ring_bytes_ > capacity_.bytes);
+        if (!exceeds_duration && !exceeds_bytes) {
+            break;
+        }
+        ring_bytes_ -= sizeOf(*oldest);
+        ring_.pop_front();
+    }
+}
+
+void BlackBox::dispatch_(Job&& job) {
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        writer_queue_.emplace_back(std::move(job));
+    }
+    writer_cv_.notify_one();
+}
+
+void BlackBox::write_(Job& job) {
+    std::filesystem::create_directories(directory_);
+
+    const auto name = (prefix_.empty() ? "" : prefix_ + "_") + std::to_string(job.window.event_stamp) + ".bin";
+    const auto path = directory_ / name;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw exception::GenericException("failed to open " + path.string());
+    }
+
+    for (const auto& image : job.frames) {
+        Record record;
+        record.stamp    = image->header.stamp;
+        record.seq      = image->header.seq;
+        record.rows     = image->rows;
+        record.cols     = image->cols;
+        record.step     = image->step;
+        record.depth    = image->depth;
+        record.size     = sizeOf(*image);
+        record.complete = image->complete;
+
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(image->data.get()), static_cast<std::streamsize>(record.size));
+    }
+
+    if (!file.good()) {
+        throw exception::GenericException("failed to write " + path.string());
+    }
+    job.frames.clear();  // hands the buffers back as early as possible
+    job.promise.set_value(path);
+}
+
+void BlackBox::run_() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            writer_cv_.wait(lock, [this]() { return stop_requested_ || !writer_queue_.empty(); });
+            if (writer_queue_.empty()) {
+                return;  // stop requested and nothing left to write
+            }
+            job = std::move(writer_queue_.front());
+            writer_queue_.pop_front();
+        }
+        try {
+            write_(job);
+        } catch (...) { job.promise.set_exception(std::current_exception()); }
+    }
+}
+
+}  // namespace camera
@@ -0,0 +1,267 @@
+#include <cstring>
+
+#include <turbojpeg.h>
+
+#include "camera/clock.hpp"
+#include "camera/encoder.h"
+#include "camera/exception.h"
+
+namespace camera {
+
+namespace {
+thread_local const JpegEncoder* t_delivering = nullptr;  // encoder whose callback runs on this thread
+
+bool isSupported(const PixelFormat format) {
+    switch (format) {
+    case PixelFormat::MONO8:
+    case PixelFormat::RGB8:
+    case PixelFormat::BGR8:
+    case PixelFormat::BAYER_RG8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Mirrors an index past either end of [0, size) back inside, keeping its parity and so its Bayer color.
+ */
+std::size_t reflect(const std::ptrdiff_t i, const std::size_t size) {
+    if (size < 2) {
+        return 0;
+    }
+    if (i < 0) {
+        return 1;
+    }
+    return (static_cast<std::size_t>(i) < size) ? static_cast<std::size_t>(i) : size - 2;
+}
+
+/**
+ * @brief Demosaics a BayerRG8 image into RGB8 by bilinear interpolation: each missing color of a pixel is the mean of
+ *      its nearest neighbors of that color, across the edges of the image mirrored.
+ */
+void demosaicRG8(const IImage& image, std::vector<uint8_t>& rgb) {
+    const std::size_t rows = image.rows;
+    const std::size_t cols = image.cols;
+    const std::size_t step = image.step;
+    const uint8_t*    src  = image.data.get();
+
+    rgb.resize(rows * cols * 3);
+    uint8_t* out = rgb.data();
+
+    for (std::size_t y = 0; y < rows; y++) {
+        const uint8_t* above = src + reflect(static_cast<std::ptrdiff_t>(y) - 1, rows) * step;
+        const uint8_t* row   = src + y * step;
+        const uint8_t* below = src + reflect(static_cast<std::ptrdiff_t>(y) + 1, rows) * step;
+        for (std::size_t x = 0; x < cols; x++, out += 3) {
+            const std::size_t left  = reflect(static_cast<std::ptrdiff_t>(x) - 1, cols);
+            const std::size_t right = reflect(static_cast<std::ptrdiff_t>(x) + 1, cols);
+
+            const int center   = row[x];
+            const int cross    = (above[x] + below[x] + row[left] + row[right] + 2) >> 2;
+            const int diagonal = (above[left] + above[right] + below[left] + below[right] + 2) >> 2;
+            const int vertical = (above[x] + below[x] + 1) >> 1;
+            const int lateral  = (row[left] + row[right] + 1) >> 1;
+
+            const bool is_red_row    = (y % 2 == 0);
+            const bool is_red_column = (x % 2 == 0);
+            if (is_red_row && is_red_column) {
+                out[0] = static_cast<uint8_t>(center);
+                out[1] = static_cast<uint8_t>(cross);
+                out[2] = static_cast<uint8_t>(diagonal);
+            } else if (is_red_row) {
+                out[0] = static_cast<uint8_t>(lateral);
+                out[1] = static_cast<uint8_t>(center);
+                out[2] = static_cast<uint8_t>(vertical);
+            } else if (is_red_column) {
+                out[0] = static_cast<uint8_t>(vertical);
+                out[1] = static_cast<uint8_t>(center);
+                out[2] = static_cast<uint8_t>(lateral);
+            } else {
+                out[0] = static_cast<uint8_t>(diagonal);
+                out[1] = static_cast<uint8_t>(cross);
+                out[2] = static_cast<uint8_t>(center);
+            }
+        }
+    }
+}
+}  // namespace
+
+JpegEncoder::JpegEncoder(const Options& options, Callback callback)
+    : options_(options)
+    , callback_(std::move(callback)) {
+    const auto num_threads = (options_.num_threads > 0) ? options_.num_threads : 1;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back(&JpegEncoder::run_, this);
+    }
+}
+
+JpegEncoder::~JpegEncoder() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stop_requested_ = true;
+    }
+    queue_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool JpegEncoder::submit(std::shared_ptr<const IImage> image) {
+    if (image == nullptr) {
+        return false;
+    }
+    if (!isSupported(image->format)) {
+        throw exception::InvalidConfigValue("unsupported pixel format for jpeg encoding");
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (pending_ >= options_.max_pending) {
+            return false;
+        }
+        Job job;
+        job.index        = next_index_++;
+        job.image        = std::move(image);
+        job.submitted_ns = static_cast<uint64_t>(steadyNs());
+        queue_.emplace_back(std::move(job));
+        pending_++;
+    }
+    queue_cv_.notify_one();
+    return true;
+}
+
+void JpegEncoder::flush() {
+    std::unique_lock<std::mutex> lock(delivery_mutex_);
+    if (t_delivering != this) {
+        flush_cv_.wait(lock, [this]() { return pending_ == 0 && !delivering_; });
+        return;
+    }
+    // called from the callback, whose thread is the one delivering, so it delivers the remaining frames itself
+    while (pending_ > 0) {
+        delivery_cv_.wait(lock, [this]() {
+            return pending_ == 0 || (!completed_.empty() && completed_.begin()->first == next_delivery_);
+        });
+        deliverReady_(lock);
+    }
+}
+
+void JpegEncoder::run_() {
+    tjhandle             handle        = tjInitCompress();
+    unsigned char*       jpeg          = nullptr;
+    unsigned long        jpeg_capacity = 0;
+    std::vector<uint8_t> rgb;
+
+    const int flags = TJFLAG_NOREALLOC | (options_.fast_dct ? TJFLAG_FASTDCT : 0);
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this]() { return stop_requested_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                break;
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        const auto& image = *job.image;
+        const auto  begin = static_cast<uint64_t>(steadyNs());
+
+        const uint8_t* src         = image.data.get();
+        int            pitch       = static_cast<int>(image.step);
+        int            pixel       = TJPF_RGB;
+        int            subsampling = TJSAMP_420;
+        switch (image.format) {
+        case PixelFormat::MONO8:
+            pixel       = TJPF_GRAY;
+            subsampling = TJSAMP_GRAY;
+            break;
+        case PixelFormat::BGR8:
+            pixel = TJPF_BGR;
+            break;
+        case PixelFormat::BAYER_RG8:
+            demosaicRG8(image, rgb);
+            src   = rgb.data();
+            pitch = static_cast<int>(image.cols * 3);
+            break;
+        default:
+            break;
+        }
+
+        Frame frame;
+        frame.header = image.header;
+        frame.rows   = image.rows;
+        frame.cols   = image.cols;
+
+        const int width  = static_cast<int>(image.cols);
+        const int height = static_cast<int>(image.rows);
+
+        const unsigned long required = tjBufSize(width, height, subsampling);
+        if (required > jpeg_capacity) {  // the output buffer only grows, and is reused for every frame
+            tjFree(jpeg);
+            jpeg          = tjAlloc(static_cast<int>(required));
+            jpeg_capacity = (jpeg != nullptr) ? required : 0;
+        }
+
+        unsigned long jpeg_size = jpeg_capacity;
+        const int     result    = (handle == nullptr || jpeg == nullptr)
+                                    ? -1
+                                    : tjCompress2(handle, src, width, pitch, height, pixel, &jpeg, &jpeg_size,
+                                                  subsampling, options_.quality, flags);
+        if (result == 0) {
+            frame.jpeg.assign(jpeg, jpeg + jpeg_size);
+        } else {
+            frame.failed = true;  // still delivered, which keeps the order of the others intact
+        }
+
+        const auto end   = static_cast<uint64_t>(steadyNs());
+        frame.encode_ns  = end - begin;
+        frame.latency_ns = end - job.submitted_ns;
+        job.image.reset();
+
+        deliver_(job.index, std::move(frame));
+    }
+
+    tjFree(jpeg);
+    if (handle != nullptr) {
+        tjDestroy(handle);
+    }
+}
+
+void JpegEncoder::deliver_(const uint64_t index, Frame&& frame) {
+    std::unique_lock<std::mutex> lock(delivery_mutex_);
+    completed_.emplace(index, std::move(frame));
+    if (delivering_) {
+        delivery_cv_.notify_all();  // the thread delivering picks the frame up in order
+        return;
+    }
+    deliverReady_(lock);
+}
+
+void JpegEncoder::deliverReady_(std::unique_lock<std::mutex>& lock) {
+    const bool was_delivering = delivering_;
+    delivering_               = true;
+    while (!completed_.empty() && completed_.begin()->first == next_delivery_) {
+        auto ready = std::move(completed_.begin()->second);
+        completed_.erase(completed_.begin());
+        next_delivery_++;
+        pending_--;
+
+        // the callback runs unlocked, so that it may submit or flush itself
+        lock.unlock();
+        const JpegEncoder* const outer = t_delivering;
+        t_delivering                   = this;
+        if (callback_) {
+            callback_(std::move(ready));
+        }
+        t_delivering = outer;
+        lock.lock();
+    }
+    delivering_ = was_delivering;
+    if (!delivering_) {
+        flush_cv_.notify_all();
+    }
+}
+
+}  // namespace camera
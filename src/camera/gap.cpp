@@ -0,0 +1,108 @@
+#include "camera/gap.h"
+
+namespace camera {
+
+void GapTracker::setCallback(Callback callback) {
+    callback_ = std::move(callback);
+}
+
+void GapTracker::setStreamCounters(StreamCounters counters) {
+    counters_ = std::move(counters);
+}
+
+bool GapTracker::observe(const IImage& image) {
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    bool is_lost = false;
+
+    const auto seq = image.header.seq;
+    if (has_seq_.exchange(true, std::memory_order_relaxed)) {
+        const auto last = last_seq_.load(std::memory_order_relaxed);
+        if (seq <= last) {
+            restarts_.fetch_add(1, std::memory_order_relaxed);
+        } else if (seq > last + 1) {
+            const auto count = seq - last - 1;
+            gaps_.fetch_add(1, std::memory_order_relaxed);
+            skipped_.fetch_add(count, std::memory_order_relaxed);
+            emit_(Event::Kind::SKIPPED, image, count);
+            is_lost = true;
+        }
+    }
+    last_seq_.store(seq, std::memory_order_relaxed);
+    last_stamp_.store(image.header.stamp, std::memory_order_relaxed);
+
+    if (!image.complete) {
+        incomplete_.fetch_add(1, std::memory_order_relaxed);
+        emit_(Event::Kind::INCOMPLETE, image, 1);
+        is_lost = true;
+    }
+
+    if (is_lost) {
+        sampleStream_(image);
+    }
+    return is_lost;
+}
+
+void GapTracker::disconnected() {
+    disconnects_.fetch_add(1, std::memory_order_relaxed);
+    if (callback_) {
+        callback_(Event{Event::Kind::DISCONNECTED, last_seq_.load(std::memory_order_relaxed),
+                        last_stamp_.load(std::memory_order_relaxed), 0});
+    }
+}
+
+void GapTracker::reconnected(const IImage& image, const uint64_t count) {
+    reconnects_.fetch_add(1, std::memory_order_relaxed);
+    emit_(Event::Kind::RECONNECTED, image, count);
+}
+
+void GapTracker::restart() {
+    has_seq_.store(false, std::memory_order_relaxed);
+    last_lost_frames_.store(0, std::memory_order_relaxed);
+    last_missed_packets_.store(0, std::memory_order_relaxed);
+}
+
+GapTracker::Stats GapTracker::stats() const {
+    Stats stats;
+    stats.frames         = frames_.load(std::memory_order_relaxed);
+    stats.gaps           = gaps_.load(std::memory_order_relaxed);
+    stats.skipped        = skipped_.load(std::memory_order_relaxed);
+    stats.incomplete     = incomplete_.load(std::memory_order_relaxed);
+    stats.restarts       = restarts_.load(std::memory_order_relaxed);
+    stats.lost_frames    = lost_frames_.load(std::memory_order_relaxed);
+    stats.missed_packets = missed_packets_.load(std::memory_order_relaxed);
+    stats.disconnects    = disconnects_.load(std::memory_order_relaxed);
+    stats.reconnects     = reconnects_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void GapTracker::emit_(const Event::Kind kind, const IImage& image, const uint64_t count) const {
+    if (callback_) {
+        callback_(Event{kind, image.header.seq, image.header.stamp, count});
+    }
+}
+
+void GapTracker::sampleStream_(const IImage& image) {
+    if (!counters_) {
+        return;
+    }
+    int64_t lost_frames    = 0;
+    int64_t missed_packets = 0;
+    if (!counters_(lost_frames, missed_packets)) {
+        return;
+    }
+
+    // the counters are cumulative over the stream, so only their growth since the last sample is new
+    const auto new_lost_frames = lost_frames - last_lost_frames_.exchange(lost_frames, std::memory_order_relaxed);
+    if (new_lost_frames > 0) {
+        lost_frames_.fetch_add(static_cast<uint64_t>(new_lost_frames), std::memory_order_relaxed);
+        emit_(Event::Kind::LOST_FRAMES, image, static_cast<uint64_t>(new_lost_frames));
+    }
+    const auto new_missed_packets =
+        missed_packets - last_missed_packets_.exchange(missed_packets, std::memory_order_relaxed);
+    if (new_missed_packets > 0) {
+        missed_packets_.fetch_add(static_cast<uint64_t>(new_missed_packets), std::memory_order_relaxed);
+        emit_(Event::Kind::MISSED_PACKETS, image, static_cast<uint64_t>(new_missed_packets));
+    }
+}
+
+}  // namespace camera
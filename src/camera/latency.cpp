@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "camera/clock.hpp"
+#include "camera/latency.h"
+
+namespace camera {
+
+namespace {
+int exponentOf(const uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+}  // namespace
+
+void LatencyHistogram::record(const int64_t ns) {
+    const auto value = static_cast<uint64_t>(std::max<int64_t>(ns, 0));
+    buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    auto max_ns = max_ns_.load(std::memory_order_relaxed);
+    while (static_cast<int64_t>(value) > max_ns
+           && !max_ns_.compare_exchange_weak(max_ns, static_cast<int64_t>(value), std::memory_order_relaxed)) {}
+}
+
+int64_t LatencyHistogram::percentile(const double percentile) const {
+    const auto count = count_.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return 0;
+    }
+    // the rank of the value, counted from 1
+    const auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)), 1);
+
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kBuckets; bucket++) {
+        seen += buckets_[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(valueOf(bucket), max_ns_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_ns_.load(std::memory_order_relaxed);  // values recorded while counting
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const {
+    Summary summary;
+    summary.count   = count_.load(std::memory_order_relaxed);
+    summary.p50_ns  = percentile(50.0);
+    summary.p99_ns  = percentile(99.0);
+    summary.p999_ns = percentile(99.9);
+    summary.max_ns  = max_ns_.load(std::memory_order_relaxed);
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+std::size_t LatencyHistogram::bucketOf(const uint64_t ns) {
+    if (ns < kSubBuckets) {
+        return static_cast<std::size_t>(ns);
+    }
+    const auto exponent = exponentOf(ns);
+    if (exponent >= kMaxExponent) {
+        return kBuckets - 1;
+    }
+    // the bits below the leading one select the sub-bucket
+    const auto shift = exponent - kSubBucketBits;
+    const auto sub   = static_cast<std::size_t>(ns >> shift) & (kSubBuckets - 1);
+    return kSubBuckets * static_cast<std::size_t>(shift + 1) + sub;
+}
+
+int64_t LatencyHistogram::valueOf(const std::size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return static_cast<int64_t>(bucket);
+    }
+    const auto shift = static_cast<int>(bucket / kSubBuckets) - 1;
+    const auto sub   = static_cast<int64_t>(bucket % kSubBuckets);
+    const auto lower = (static_cast<int64_t>(kSubBuckets) + sub) << shift;
+    return lower + ((int64_t{1} << shift) >> 1);
+}
+
+FrameLatency::FrameLatency() {
+    names_[DEQUEUE] = "dequeue";
+    names_[CAPTURE] = "capture";
+    stages_.store(CAPTURE + 1);
+}
+
+void FrameLatency::setDeviceClock(DeviceClock clock) {
+    clock_ = std::move(clock);
+}
+
+std::size_t FrameLatency::addStage(const std::string& name) {
+    const auto stage = stages_.load();
+    if (stage >= kMaxStages) {
+        throw std::length_error("too many latency stages");
+    }
+    names_[stage] = name;
+    stages_.store(stage + 1);
+    return stage;
+}
+
+void FrameLatency::captured(const IImage& image, const uint64_t returned_ns) {
+    if (clock_) {
+        const auto exposed_ns = clock_(image.header.stamp);
+        histograms_[DEQUEUE].record(static_cast<int64_t>(image.header.dequeue_stamp - exposed_ns));
+    }
+    record(CAPTURE, image, returned_ns);
+}
+
+void FrameLatency::record(const std::size_t stage, const IImage& image, const uint64_t done_ns) {
+    histograms_.at(stage).record(static_cast<int64_t>(done_ns - image.header.dequeue_stamp));
+}
+
+void FrameLatency::record(const std::size_t stage, const IImage& image) {
+    record(stage, image, static_cast<uint64_t>(steadyNs()));
+}
+
+const LatencyHistogram& FrameLatency::histogram(const std::size_t stage) const {
+    return histograms_.at(stage);
+}
+
+std::vector<FrameLatency::Report> FrameLatency::report() const {
+    std::vector<Report> reports;
+    const auto          stages = stages_.load();
+    for (std::size_t stage = 0; stage < stages; stage++) {
+        reports.push_back(Report{names_[stage], histograms_[stage].summary()});
+    }
+    return reports;
+}
+
+void FrameLatency::reset() {
+    for (auto& histogram : histograms_) {
+        histogram.reset();
+    }
+}
+
+}  // namespace camera
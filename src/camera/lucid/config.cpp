@@ -7,20 +7,27 @@ namespace camera {
 namespace lucid {
 
 namespace {
+/**
+ * @brief Finds the node map holding a node, among the maps of the device, its stream and the system.
+ * @return nullptr if no map holds the node.
+ */
+GenApi::INodeMap* nodeMapOf(Arena::ISystem* system, Arena::IDevice* device, const char* node) {
+    if (device->GetNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
+        return device->GetNodeMap();
+    } else if (device->GetTLStreamNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
+        return device->GetTLStreamNodeMap();
+    } else if (system->GetTLSystemNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
+        return system->GetTLSystemNodeMap();
+    } else if (device->GetTLDeviceNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
+        return device->GetTLDeviceNodeMap();
+    }
+    return nullptr;
+}
+
 template<typename T>
 void setParameter(Arena::ISystem* system, Arena::IDevice* device, const char* node, const T value) {
     try {
-        GenApi::INodeMap* node_map(nullptr);
-        if (device->GetNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetNodeMap();
-        } else if (device->GetTLStreamNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetTLStreamNodeMap();
-        } else if (system->GetTLSystemNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = system->GetTLSystemNodeMap();
-        } else if (device->GetTLDeviceNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetTLDeviceNodeMap();
-        }
-        Arena::SetNodeValue<T>(node_map, GenICam::gcstring(node), value);
+        Arena::SetNodeValue<T>(nodeMapOf(system, device, node), GenICam::gcstring(node), value);
     } catch (const GenICam::GenericException& e) {
         if (std::string(node) != "PixelFormat") {
             throw exception::InvalidConfigValue(e.what());
@@ -32,17 +39,7 @@ template<typename T>
 T getParameter(Arena::ISystem* system, Arena::IDevice* device, const char* node) {
     T result{};
     try {
-        GenApi::INodeMap* node_map(nullptr);
-        if (device->GetNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetNodeMap();
-        } else if (device->GetTLStreamNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetTLStreamNodeMap();
-        } else if (system->GetTLSystemNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = system->GetTLSystemNodeMap();
-        } else if (device->GetTLDeviceNodeMap()->GetNode(GenICam::gcstring(node)) != nullptr) {
-            node_map = device->GetTLDeviceNodeMap();
-        }
-        result = Arena::GetNodeValue<T>(node_map, GenICam::gcstring(node));
+        result = Arena::GetNodeValue<T>(nodeMapOf(system, device, node), GenICam::gcstring(node));
     } catch (const GenICam::GenericException& e) {
         if (std::string(node) != "PixelFormat") {
             throw exception::InvalidConfigValue(e.what());
@@ -51,6 +48,12 @@ T getParameter(Arena::ISystem* system, Arena::IDevice* device, const char* node)
     return result;
 }
 
+void executeCommand(Arena::IDevice* device, const char* node) {
+    try {
+        Arena::ExecuteNode(device->GetNodeMap(), GenICam::gcstring(node));
+    } catch (const GenICam::GenericException& e) { throw exception::InvalidConfigValue(e.what()); }
+}
+
 /**
  * @brief Converts IP address from integer to string.
  *
@@ -84,6 +87,33 @@ Config::Config(Arena::ISystem* system, Arena::IDevice* device)
 
 Config::~Config() {}
 
+template<typename E>
+void Config::setEnumeration_(Enumeration<E>& enumeration, const char* node, const E value) {
+    try {
+        std::call_once(enumeration.once, [&]() {
+            auto*                   node_map = nodeMapOf(system_, device_, node);
+            GenApi::CEnumerationPtr found =
+                (node_map != nullptr) ? node_map->GetNode(GenICam::gcstring(node)) : nullptr;
+            if (!found) {
+                throw exception::InvalidConfigValue(std::string(node) + " is not an enumeration");
+            }
+            for (std::size_t i = 0; i < enumeration.values.size(); i++) {
+                GenApi::CEnumEntryPtr entry = found->GetEntryByName(GenICam::gcstring(EnumNames<E>::names[i]));
+                if (entry) {
+                    enumeration.values[i] = entry->GetValue();
+                }
+            }
+            enumeration.node = found;
+        });
+
+        const auto& entry_value = enumeration.values[static_cast<std::size_t>(value)];
+        if (!entry_value) {
+            throw exception::InvalidConfigValue(std::string("unknown entry ") + nameOf(value) + " of " + node);
+        }
+        enumeration.node->SetIntValue(*entry_value);
+    } catch (const GenICam::GenericException& e) { throw exception::InvalidConfigValue(e.what()); }
+}
+
 void Config::setActionCommandExecuteTime(const int64_t value) {
     setParameter<int64_t>(system_, device_, "ActionCommandExecuteTime", value);
 }
@@ -124,8 +154,8 @@ int64_t Config::getActionSelector() const {
     return getParameter<int64_t>(system_, device_, "ActionSelector");
 }
 
-void Config::setActionUnconditionalMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "ActionUnconditionalMode", static_cast<GenICam::gcstring>(value));
+void Config::setActionUnconditionalMode(const Switch value) {
+    setEnumeration_(action_unconditional_mode_, "ActionUnconditionalMode", value);
 }
 
 std::string Config::getActionUnconditionalMode() const {
@@ -152,16 +182,16 @@ bool Config::getAcquisitionFrameRateEnable() const {
     return getParameter<bool>(system_, device_, "AcquisitionFrameRateEnable");
 }
 
-void Config::setAcquisitionMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "AcquisitionMode", static_cast<GenICam::gcstring>(value));
+void Config::setAcquisitionMode(const AcquisitionMode value) {
+    setEnumeration_(acquisition_mode_, "AcquisitionMode", value);
 }
 
 std::string Config::getAcquisitionMode() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "AcquisitionMode").c_str());
 }
 
-void Config::setAcquisitionStartMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "AcquisitionStartMode", static_cast<GenICam::gcstring>(value));
+void Config::setAcquisitionStartMode(const AcquisitionStartMode value) {
+    setEnumeration_(acquisition_start_mode_, "AcquisitionStartMode", value);
 }
 
 std::string Config::getAcquisitionStartMode() const {
@@ -176,16 +206,16 @@ int64_t Config::getBinningHorizontal() const {
     return getParameter<int64_t>(system_, device_, "BinningHorizontal");
 }
 
-void Config::setBinningHorizontalMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "BinningHorizontalMode", static_cast<GenICam::gcstring>(value));
+void Config::setBinningHorizontalMode(const BinningMode value) {
+    setEnumeration_(binning_horizontal_mode_, "BinningHorizontalMode", value);
 }
 
 std::string Config::getBinningHorizontalMode() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "BinningHorizontalMode").c_str());
 }
 
-void Config::setBinningSelector(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "BinningSelector", static_cast<GenICam::gcstring>(value));
+void Config::setBinningSelector(const BinningSelector value) {
+    setEnumeration_(binning_selector_, "BinningSelector", value);
 }
 
 std::string Config::getBinningSelector() const {
@@ -200,16 +230,40 @@ int64_t Config::getBinningVertical() const {
     return getParameter<int64_t>(system_, device_, "BinningVertical");
 }
 
-void Config::setBinningVerticalMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "BinningVerticalMode", static_cast<GenICam::gcstring>(value));
+void Config::setBinningVerticalMode(const BinningMode value) {
+    setEnumeration_(binning_vertical_mode_, "BinningVerticalMode", value);
 }
 
 std::string Config::getBinningVerticalMode() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "BinningVerticalMode").c_str());
 }
 
-void Config::setConversionGain(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "ConversionGain", static_cast<GenICam::gcstring>(value));
+void Config::setChunkEnable(const bool value) {
+    setParameter<bool>(system_, device_, "ChunkEnable", value);
+}
+
+bool Config::getChunkEnable() const {
+    return getParameter<bool>(system_, device_, "ChunkEnable");
+}
+
+void Config::setChunkModeActive(const bool value) {
+    setParameter<bool>(system_, device_, "ChunkModeActive", value);
+}
+
+bool Config::getChunkModeActive() const {
+    return getParameter<bool>(system_, device_, "ChunkModeActive");
+}
+
+void Config::setChunkSelector(const char* value) {
+    setParameter<GenICam::gcstring>(system_, device_, "ChunkSelector", value);
+}
+
+std::string Config::getChunkSelector() const {
+    return std::string(getParameter<GenICam::gcstring>(system_, device_, "ChunkSelector").c_str());
+}
+
+void Config::setConversionGain(const ConversionGain value) {
+    setEnumeration_(conversion_gain_, "ConversionGain", value);
 }
 
 std::string Config::getConversionGain() const {
@@ -220,20 +274,24 @@ std::string Config::getDeviceAccessStatus() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "DeviceAccessStatus").c_str());
 }
 
+int64_t Config::getDeviceLinkSpeed() const {
+    return getParameter<int64_t>(system_, device_, "DeviceLinkSpeed");
+}
+
 double Config::getDeviceTemperature() const {
     return getParameter<double>(system_, device_, "DeviceTemperature");
 }
 
-void Config::setExposureAuto(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "ExposureAuto", static_cast<GenICam::gcstring>(value));
+void Config::setExposureAuto(const AutoMode value) {
+    setEnumeration_(exposure_auto_, "ExposureAuto", value);
 }
 
 std::string Config::getExposureAuto() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "ExposureAuto").c_str());
 }
 
-void Config::setExposureAutoLimitAuto(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "ExposureAutoLimitAuto", static_cast<GenICam::gcstring>(value));
+void Config::setExposureAutoLimitAuto(const AutoMode value) {
+    setEnumeration_(exposure_auto_limit_auto_, "ExposureAutoLimitAuto", value);
 }
 
 [[nodiscard]] std::string Config::getExposureAutoLimitAuto() const {
@@ -264,8 +322,8 @@ void Config::setExposureTime(const double value) {
     return getParameter<double>(system_, device_, "ExposureTime");
 }
 
-void Config::setGainAuto(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "GainAuto", static_cast<GenICam::gcstring>(value));
+void Config::setGainAuto(const AutoMode value) {
+    setEnumeration_(gain_auto_, "GainAuto", value);
 }
 
 std::string Config::getGainAuto() const {
@@ -352,6 +410,14 @@ std::string Config::getGevSCDAStr() const {
     return toStrIPAddress(getParameter<int64_t>(system_, device_, "GevSCDA"));
 }
 
+void Config::setGevSCPD(const int64_t value) {
+    setParameter<int64_t>(system_, device_, "GevSCPD", value);
+}
+
+int64_t Config::getGevSCPD() const {
+    return getParameter<int64_t>(system_, device_, "GevSCPD");
+}
+
 void Config::setGevSCPSPacketSize(const int64_t value) {
     setParameter<int64_t>(system_, device_, "GevSCPSPacketSize", value);
 }
@@ -380,6 +446,10 @@ std::string Config::getPixelFormat() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "PixelFormat").c_str());
 }
 
+int64_t Config::getPayloadSize() const {
+    return getParameter<int64_t>(system_, device_, "PayloadSize");
+}
+
 void Config::setPtpEnable(const bool value) {
     setParameter<bool>(system_, device_, "PtpEnable", value);
 }
@@ -400,6 +470,10 @@ std::string Config::getPtpStatus() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "PtpStatus").c_str());
 }
 
+int64_t Config::getPtpOffsetFromMaster() const {
+    return getParameter<int64_t>(system_, device_, "PtpOffsetFromMaster");
+}
+
 void Config::setReverseX(const bool value) {
     setParameter<bool>(system_, device_, "ReverseX", value);
 }
@@ -425,8 +499,7 @@ bool Config::getReverseY() const {
 }
 
 void Config::setScan3dCoordinateSelector(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "Scan3dCoordinateSelector",
-                                    static_cast<GenICam::gcstring>(value));
+    setParameter<GenICam::gcstring>(system_, device_, "Scan3dCoordinateSelector", value);
 }
 
 std::string Config::getScan3dCoordinateSelector() const {
@@ -434,7 +507,7 @@ std::string Config::getScan3dCoordinateSelector() const {
 }
 
 void Config::setScan3dModeSelector(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "Scan3dModeSelector", static_cast<GenICam::gcstring>(value));
+    setParameter<GenICam::gcstring>(system_, device_, "Scan3dModeSelector", value);
 }
 
 std::string Config::getScan3dModeSelector() const {
@@ -449,9 +522,8 @@ bool Config::getStreamAutoNegotiatePacketSize() const {
     return getParameter<bool>(system_, device_, "StreamAutoNegotiatePacketSize");
 }
 
-void Config::setStreamBufferHandlingMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "StreamBufferHandlingMode",
-                                    static_cast<GenICam::gcstring>(value));
+void Config::setStreamBufferHandlingMode(const StreamBufferHandlingMode value) {
+    setEnumeration_(stream_buffer_handling_mode_, "StreamBufferHandlingMode", value);
 }
 
 std::string Config::getStreamBufferHandlingMode() const {
@@ -466,6 +538,10 @@ int64_t Config::getStreamMissedPacketCount() const {
     return getParameter<int64_t>(system_, device_, "StreamMissedPacketCount");
 }
 
+int64_t Config::getStreamResendRequestCount() const {
+    return getParameter<int64_t>(system_, device_, "StreamResendRequestCount");
+}
+
 void Config::setStreamMulticastEnable(const bool value) {
     setParameter<bool>(system_, device_, "StreamMulticastEnable", value);
 }
@@ -490,16 +566,24 @@ int64_t Config::getTargetBrightness() const {
     return getParameter<int64_t>(system_, device_, "TargetBrightness");
 }
 
-void Config::setTransferControlMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TransferControlMode", static_cast<GenICam::gcstring>(value));
+void Config::executeTimestampLatch() {
+    executeCommand(device_, "TimestampLatch");
+}
+
+int64_t Config::getTimestampLatchValue() const {
+    return getParameter<int64_t>(system_, device_, "TimestampLatchValue");
+}
+
+void Config::setTransferControlMode(const TransferControlMode value) {
+    setEnumeration_(transfer_control_mode_, "TransferControlMode", value);
 }
 
 std::string Config::getTransferControlMode() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TransferControlMode").c_str());
 }
 
-void Config::setTransferOperationMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TransferOperationMode", static_cast<GenICam::gcstring>(value));
+void Config::setTransferOperationMode(const TransferOperationMode value) {
+    setEnumeration_(transfer_operation_mode_, "TransferOperationMode", value);
 }
 
 std::string Config::getTransferOperationMode() const {
@@ -507,15 +591,15 @@ std::string Config::getTransferOperationMode() const {
 }
 
 void Config::setTransferSelector(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TransferSelector", static_cast<GenICam::gcstring>(value));
+    setParameter<GenICam::gcstring>(system_, device_, "TransferSelector", value);
 }
 
 std::string Config::getTransferSelector() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TransferSelector").c_str());
 }
 
-void Config::setTriggerActivation(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerActivation", static_cast<GenICam::gcstring>(value));
+void Config::setTriggerActivation(const TriggerActivation value) {
+    setEnumeration_(trigger_activation_, "TriggerActivation", value);
 }
 
 std::string Config::getTriggerActivation() const {
@@ -534,32 +618,32 @@ double Config::getTriggerDelay() const {
     return getParameter<double>(system_, device_, "TriggerDelay");
 }
 
-void Config::setTriggerLatency(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerLatency", static_cast<GenICam::gcstring>(value));
+void Config::setTriggerLatency(const TriggerLatency value) {
+    setEnumeration_(trigger_latency_, "TriggerLatency", value);
 }
 
 std::string Config::getTriggerLatency() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TriggerLatency").c_str());
 }
 
-void Config::setTriggerMode(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerMode", static_cast<GenICam::gcstring>(value));
+void Config::setTriggerMode(const Switch value) {
+    setEnumeration_(trigger_mode_, "TriggerMode", value);
 }
 
 std::string Config::getTriggerMode() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TriggerMode").c_str());
 }
 
-void Config::setTriggerOverlap(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerOverlap", static_cast<GenICam::gcstring>(value));
+void Config::setTriggerOverlap(const TriggerOverlap value) {
+    setEnumeration_(trigger_overlap_, "TriggerOverlap", value);
 }
 
 std::string Config::getTriggerOverlap() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TriggerOverlap").c_str());
 }
 
-void Config::setTriggerSelector(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerSelector", static_cast<GenICam::gcstring>(value));
+void Config::setTriggerSelector(const TriggerSelector value) {
+    setEnumeration_(trigger_selector_, "TriggerSelector", value);
 }
 
 std::string Config::getTriggerSelector() const {
@@ -567,13 +651,37 @@ std::string Config::getTriggerSelector() const {
 }
 
 void Config::setTriggerSource(const char* value) {
-    setParameter<GenICam::gcstring>(system_, device_, "TriggerSource", static_cast<GenICam::gcstring>(value));
+    setParameter<GenICam::gcstring>(system_, device_, "TriggerSource", value);
 }
 
 std::string Config::getTriggerSource() const {
     return std::string(getParameter<GenICam::gcstring>(system_, device_, "TriggerSource").c_str());
 }
 
+void Config::setUserSetSelector(const char* value) {
+    setParameter<GenICam::gcstring>(system_, device_, "UserSetSelector", value);
+}
+
+std::string Config::getUserSetSelector() const {
+    return std::string(getParameter<GenICam::gcstring>(system_, device_, "UserSetSelector").c_str());
+}
+
+void Config::setUserSetDefault(const char* value) {
+    setParameter<GenICam::gcstring>(system_, device_, "UserSetDefault", value);
+}
+
+std::string Config::getUserSetDefault() const {
+    return std::string(getParameter<GenICam::gcstring>(system_, device_, "UserSetDefault").c_str());
+}
+
+void Config::executeUserSetLoad() {
+    executeCommand(device_, "UserSetLoad");
+}
+
+void Config::executeUserSetSave() {
+    executeCommand(device_, "UserSetSave");
+}
+
 void Config::setWidth(const int64_t value) {
     setParameter<int64_t>(system_, device_, "Width", value);
 }
@@ -1,51 +1,166 @@
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <thread>
 
 #include <arpa/inet.h>
 
+#include "camera/clock.hpp"
 #include "camera/lucid/device.hpp"
 #include "camera/lucid/network.hpp"
+#include "camera/lucid/spec.h"
 #include "camera/lucid/types.h"
 
 #include "camera/lucid/utils.h"
 
+#include "camera/profile.h"
+
 namespace camera {
 namespace lucid {
 
 namespace {
+constexpr int kLocateTimeoutMs = 500;   // time a recovery waits for the device to reply to discovery
+constexpr int kWatchIntervalMs = 1000;  // between checks of the link, and between attempts to recover
+
+constexpr std::size_t kMaxCachedBytes = 256UL << 20;  // idle buffers kept for reuse, as many as a pool keeps by default
+
 int64_t toIntIPAddress(const std::string& ip_address) {
     struct in_addr ip_addr;
     return (inet_aton(ip_address.c_str(), &ip_addr) == 0) ? (-1) : ntohl(ip_addr.s_addr);
 }
+
+PixelFormat pixelFormatOf(const uint64_t pfnc) {
+    switch (pfnc) {
+    case Mono8:
+        return PixelFormat::MONO8;
+    case Mono16:
+        return PixelFormat::MONO16;
+    case BayerRG8:
+        return PixelFormat::BAYER_RG8;
+    case BayerRG16:
+        return PixelFormat::BAYER_RG16;
+    case RGB8:
+        return PixelFormat::RGB8;
+    case BGR8:
+        return PixelFormat::BGR8;
+    default:
+        return PixelFormat::UNKNOWN;
+    }
+}
+
+/**
+ * @brief Gets the width or height a device is set to, which is its maximum unless a smaller size is requested.
+ */
+int64_t clampedSize(const int64_t size, const int64_t max) {
+    return ((size <= 0) || (size >= max)) ? max : size;
+}
+
+/**
+ * @brief Gets the size of the image data of a complete frame, which excludes the chunk data trailing it.
+ */
+std::size_t imageSizeOf(Arena::IImage* image) {
+    if (!image->HasChunkData()) {
+        return image->GetPayloadSize();
+    }
+    return image->GetWidth() * image->GetHeight() * image->GetBitsPerPixel() / 8;
+}
+
+/**
+ * @brief Parses the chunk data of the image. The chunk nodes are resolved from the payload itself,
+ * so it does not cause any register access on the device.
+ */
+IChunk parseChunk(Arena::IImage* image) {
+    IChunk chunk;
+    if (!image->HasChunkData()) {
+        return chunk;
+    }
+
+    auto* const         chunk_data    = image->AsChunkData();
+    GenApi::CFloatPtr   exposure_time = chunk_data->GetChunk("ChunkExposureTime");
+    GenApi::CFloatPtr   gain          = chunk_data->GetChunk("ChunkGain");
+    GenApi::CIntegerPtr frame_id      = chunk_data->GetChunk("ChunkFrameCounter");
+    GenApi::CIntegerPtr timestamp     = chunk_data->GetChunk("ChunkTimestamp");
+    GenApi::CIntegerPtr crc           = chunk_data->GetChunk("ChunkCRC");
+
+    if (GenApi::IsReadable(exposure_time)) {
+        chunk.exposure_time = exposure_time->GetValue();
+    }
+    if (GenApi::IsReadable(gain)) {
+        chunk.gain = gain->GetValue();
+    }
+    if (GenApi::IsReadable(frame_id)) {
+        chunk.frame_id = static_cast<uint64_t>(frame_id->GetValue());
+    }
+    if (GenApi::IsReadable(timestamp)) {
+        chunk.timestamp = static_cast<uint64_t>(timestamp->GetValue());
+    }
+    if (GenApi::IsReadable(crc)) {
+        chunk.crc = static_cast<uint32_t>(crc->GetValue());
+    }
+    chunk.valid = true;
+    return chunk;
+}
 }  // namespace
 
-Device::Device(Arena::ISystem* system, Arena::DeviceInfo arena_info, DeviceInfo custom_info)
+Device::Device(Arena::ISystem* system, Arena::DeviceInfo arena_info, DeviceInfo custom_info,
+               TriggerGroupResolver resolver, DeviceLocator locator)
     : arena_system_(system)
     , arena_info_(arena_info)
-    , is_available_to_capture_(false) {
+    , pool_(std::make_shared<BufferPool>(kMaxCachedBytes, frameSizesOf(specOf(utils::parseModel(custom_info.model)))))
+    , resolver_(std::move(resolver))
+    , is_available_to_capture_(false)
+    , locator_(std::move(locator)) {
     info_ = std::move(custom_info);
+    infos_.push_back(info_);
+    published_info_.store(&infos_.back());
+    gaps_.setStreamCounters([this](int64_t& lost_frames, int64_t& missed_packets) {
+        try {
+            lost_frames    = config_->getStreamLostFrameCount();
+            missed_packets = config_->getStreamMissedPacketCount();
+        } catch (const exception::InvalidConfigValue& e) { return false; }
+        return true;
+    });
+    stats_.setStreamSampler([this](StatsRecorder::StreamCounters& counters) {
+        try {
+            counters.lost_frames     = config_->getStreamLostFrameCount();
+            counters.missed_packets  = config_->getStreamMissedPacketCount();
+            counters.resend_requests = config_->getStreamResendRequestCount();
+        } catch (const exception::InvalidConfigValue& e) { return false; }
+        return true;
+    });
 }
 
-Device::~Device() {}
+Device::~Device() {
+    stopWatching_();
+}
 
 void Device::config(const DeviceParameters& param) {
+    validate(specOf(utils::parseModel(info_.model)), param);
     param_ = param;
 }
 
 void Device::open() {
-    try {
-        arena_device_ = arena_system_->CreateDevice(arena_info_);
-        config_       = std::make_shared<Config>(arena_system_, arena_device_);
-        if (config_->getDeviceAccessStatus() == "ReadWrite") {
-            applyParamsOnDevice_();
-        }
-        info_.rate = config_->getAcquisitionFrameRate();
-    } catch (const GenICam::AccessException& e) {
-        throw exception::DevicecNotAccesible();
-    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+    bool is_applied = false;
+    {
+        std::lock_guard<std::shared_mutex> lock(device_mutex_);
+        is_applied = open_();
+    }
+    if (param_.auto_reconnect && !watcher_.joinable()) {
+        stop_requested_ = false;
+        watcher_        = std::thread(&Device::watch_, this);
+    }
+    if (is_applied) {
+        std::lock_guard<std::shared_mutex> lock(device_mutex_);
+        saveProfile_();
+    }
 }
 
 void Device::release() {
+    stopWatching_();
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ == nullptr) {
+        return;  // lost, and not reopened by the recovery
+    }
     try {
         arena_system_->DestroyDevice(arena_device_);
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
@@ -53,29 +168,31 @@ void Device::release() {
 }
 
 void Device::stream(const std::size_t num_buffer) {
-    try {
-        if (info_.device_type == DeviceType::RGB_CAMERA) {
-            Arena::ExecuteNode(arena_device_->GetNodeMap(), "TransferStart");
-        }
-        arena_device_->StartStream(num_buffer);
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        is_available_to_capture_.store(true);
-    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    num_buffer_ = num_buffer;
+    stream_();
+    is_streaming_ = true;
 }
 
 void Device::stop() {
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    is_streaming_ = false;
+    if (arena_device_ == nullptr) {
+        return;  // lost, and not reopened by the recovery yet
+    }
     try {
         is_available_to_capture_.store(false);
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
         arena_device_->StopStream();
-        if (info_.device_type == DeviceType::RGB_CAMERA) {
-            Arena::ExecuteNode(arena_device_->GetNodeMap(), "TransferStop");
+        if (!param_.stream_multicast_receiver_only) {
+            stopTransfer_(arena_device_);
         }
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
 }
 
 bool Device::isConnected() {
-    return arena_device_->IsConnected();
+    std::shared_lock<std::shared_mutex> lock(device_mutex_);
+    return (arena_device_ != nullptr) && arena_device_->IsConnected();
 }
 
 bool Device::isAvailable() {
@@ -83,38 +200,299 @@ bool Device::isAvailable() {
 }
 
 std::shared_ptr<IImage> Device::capture(const int64_t timeout_ms) {
+    if (recovering_.load()) {
+        const auto                   is_recovered = [this]() { return !recovering_.load(); };
+        std::unique_lock<std::mutex> lock(watch_mutex_);
+        if (!watch_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), is_recovered)) {
+            throw exception::Timeout();
+        }
+    }
+
+    // a capture only shares the arena device, which stopping, releasing and recovering replace exclusively
+    std::shared_lock<std::shared_mutex> lock(device_mutex_);
+    std::shared_ptr<IImage>             result;
+    if (arena_device_ == nullptr) {
+        if (recovering_.load()) {
+            throw exception::Timeout();  // lost since the check above, and not reopened yet
+        }
+        throw exception::DeviceNotConnected();
+    }
+    const auto wait_start_ns = steadyNs();
     try {
-        const auto                 image = arena_device_->GetImage(timeout_ms);
-        std::unique_ptr<uint8_t[]> data(new uint8_t[image->GetSizeFilled()]);
-        std::memcpy(data.get(), image->GetData(), image->GetSizeFilled());
+        const auto image         = arena_device_->GetImage(timeout_ms);
+        const auto copy_start_ns = steadyNs();  // the stream does not stamp when it received the frame
+        const auto size          = imageSizeOf(image);
+        const auto filled        = std::min(size, image->GetSizeFilled());
+        Buffer     data          = pool_->acquire(size);
+        std::memcpy(data.get(), image->GetData(), filled);
+        std::memset(data.get() + filled, 0, size - filled);  // never hands out unfilled bytes as image data
+        const auto copy_end_ns = steadyNs();
 #if __cplusplus > 201703L  // c++20 or later
-        std::shared_ptr<IImage> result = std::make_shared<IImage>(IImage{
+        result = std::make_shared<IImage>(IImage{
             .complete = (image->GetSizeFilled() == image->GetPayloadSize()),
-            .header   = IHeader{.stamp = image->GetTimestamp(), .seq = image->GetFrameId()},
+            .header   = IHeader{.stamp      = image->GetTimestamp(),
+                                .dequeue_stamp = static_cast<uint64_t>(copy_start_ns),
+                                .seq        = image->GetFrameId(),
+                                .chunk      = parseChunk(image)},
             .rows     = image->GetHeight(),
             .cols     = image->GetWidth(),
-            .step     = (image->GetSizeFilled() / image->GetHeight()),
+            .step     = (size / image->GetHeight()),
             .depth    = image->GetBitsPerPixel(),
+            .format   = pixelFormatOf_(image->GetPixelFormat()),
             .data     = std::move(data),
         });
 #elif __cplusplus <= 201703L  // c++17 or earlier
-        std::shared_ptr<IImage> result = std::make_shared<IImage>();
-        result->complete               = (image->GetSizeFilled() == image->GetPayloadSize());
-        result->header.stamp           = image->GetTimestamp();
-        result->header.seq             = image->GetFrameId();
-        result->rows                   = image->GetHeight();
-        result->cols                   = image->GetWidth();
-        result->step                   = (image->GetSizeFilled() / image->GetHeight());
-        result->depth                  = image->GetBitsPerPixel();
-        result->data                   = std::move(data);
+        result                    = std::make_shared<IImage>();
+        result->complete          = (image->GetSizeFilled() == image->GetPayloadSize());
+        result->header.stamp      = image->GetTimestamp();
+        result->header.dequeue_stamp = static_cast<uint64_t>(copy_start_ns);
+        result->header.seq        = image->GetFrameId();
+        result->header.chunk      = parseChunk(image);
+        result->rows              = image->GetHeight();
+        result->cols              = image->GetWidth();
+        result->step              = (size / image->GetHeight());
+        result->depth             = image->GetBitsPerPixel();
+        result->format            = pixelFormatOf_(image->GetPixelFormat());
+        result->data              = std::move(data);
 #else
         throw std::runtime_error("Unsupported C++ Standard Version");
 #endif
         arena_device_->RequeueBuffer(image);
-        return result;
+        stats_.frame(size, result->complete, copy_start_ns - wait_start_ns, copy_end_ns - copy_start_ns);
     } catch (const GenICam::TimeoutException& e) {
+        stats_.underrun(steadyNs() - wait_start_ns);
+        if (param_.auto_reconnect && !arena_device_->IsConnected()) {
+            lock.unlock();
+            lose_();
+        }
         throw exception::Timeout();
+    } catch (const GenICam::GenericException& e) {
+        if (param_.auto_reconnect && !arena_device_->IsConnected()) {
+            lock.unlock();
+            lose_();
+            throw exception::Timeout();
+        }
+        throw exception::GenericException(e.what());
+    }
+
+    gaps_.observe(*result);  // may read the counters of the stream, so the device is kept until it returns
+    lock.unlock();
+
+    if (reopened_ns_.load(std::memory_order_relaxed) != 0) {
+        const auto now_ns      = steadyNs();
+        const auto reopened_ns = reopened_ns_.exchange(0);
+        const auto downtime_ns = now_ns - lost_ns_.load();
+        first_frame_ns_.store(now_ns - reopened_ns);
+        downtime_ns_.store(downtime_ns);
+        reconnects_++;
+        // frames the device would have sent meanwhile, which is unknown for triggered devices
+        const auto lost_frames = std::max(info().rate, 0.0) * static_cast<double>(downtime_ns) / 1e9;
+        gaps_.reconnected(*result, static_cast<uint64_t>(lost_frames));
+    }
+    latency_.captured(*result, static_cast<uint64_t>(steadyNs()));
+    return result;
+}
+
+std::shared_ptr<Config> Device::getConfig() const {
+    std::shared_lock<std::shared_mutex> lock(device_mutex_);
+    return config_;
+}
+
+bool Device::withConfig(const std::function<void(Config& config)>& function) {
+    std::shared_lock<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ == nullptr || config_ == nullptr) {
+        return false;
+    }
+    function(*config_);
+    return true;
+}
+
+int64_t Device::applyPacketSize(const int64_t packet_size) {
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ == nullptr || config_ == nullptr) {
+        throw exception::InvalidConfigValue("device is not opened: " + info_.serial);
+    }
+    config_->setGevSCPSPacketSize(packet_size);
+    param_.stream_packet_size = config_->getGevSCPSPacketSize();  // the device rounds to its step
+    return param_.stream_packet_size;
+}
+
+void Device::applyPacketDelay(const int64_t packet_delay) {
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ == nullptr || config_ == nullptr) {
+        throw exception::InvalidConfigValue("device is not opened: " + info_.serial);
+    }
+    config_->setGevSCPD(packet_delay);
+    param_.stream_packet_delay = packet_delay;
+}
+
+void Device::applyTriggerDelay(const double trigger_delay) {
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ == nullptr || config_ == nullptr) {
+        throw exception::InvalidConfigValue("device is not opened: " + info_.serial);
+    }
+    config_->setTriggerDelay(trigger_delay);
+    param_.trigger_delay = trigger_delay;
+}
+
+const DeviceInfo& Device::info() const {
+    return *published_info_.load(std::memory_order_acquire);
+}
+
+DeviceStats Device::stats() const {
+    return stats_.snapshot();
+}
+
+Device::Recovery Device::recovery() const {
+    Recovery recovery;
+    recovery.recovering     = recovering_.load();
+    recovery.reconnects     = reconnects_.load();
+    recovery.attempts       = attempts_.load();
+    recovery.downtime_ns    = downtime_ns_.load();
+    recovery.first_frame_ns = first_frame_ns_.load();
+    return recovery;
+}
+
+void Device::publishInfo_(const std::function<void(DeviceInfo& info)>& update) {
+    std::lock_guard<std::mutex> lock(info_mutex_);
+    auto                        info = *published_info_.load();
+    update(info);
+    infos_.push_back(std::move(info));
+    published_info_.store(&infos_.back(), std::memory_order_release);
+}
+
+bool Device::open_() {
+    // a receiver only listens to a stream another host controls, and must not take control of a device nobody holds
+    if (param_.stream_multicast_receiver_only && network::accessStatusOf(arena_system_, arena_info_) != "ReadOnly") {
+        throw exception::DevicecNotAccesible();
+    }
+    bool is_applied = false;
+    try {
+        arena_device_ = arena_system_->CreateDevice(arena_info_);
+        config_       = std::make_shared<Config>(arena_system_, arena_device_);
+        if (param_.stream_multicast_receiver_only) {
+            if (config_->getDeviceAccessStatus() != "ReadOnly") {  // the controller let go since the check above
+                arena_system_->DestroyDevice(arena_device_);
+                arena_device_ = nullptr;
+                config_       = nullptr;
+                throw exception::DevicecNotAccesible();
+            }
+            config_->setStreamMulticastEnable(true);  // stream channel of the host only, which needs no device access
+        } else if (config_->getDeviceAccessStatus() == "ReadWrite" && !loadProfile_()) {
+            applyParamsOnDevice_();
+            is_applied = true;
+        }
+        const auto rate = config_->getAcquisitionFrameRate();
+        publishInfo_([rate](DeviceInfo& info) { info.rate = rate; });
+    } catch (const GenICam::AccessException& e) {
+        throw exception::DevicecNotAccesible();
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+    return is_applied;
+}
+
+void Device::stream_() {
+    try {
+        if (!param_.stream_multicast_receiver_only) {
+            startTransfer_(arena_device_);
+        }
+        gaps_.restart();
+        stats_.restart();
+        arena_device_->StartStream(num_buffer_);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        is_available_to_capture_.store(true);
+    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+}
+
+void Device::lose_() {
+    if (recovering_.exchange(true)) {
+        return;  // already recovering
+    }
+    lost_ns_.store(steadyNs());
+    reopened_ns_.store(0);
+    is_available_to_capture_.store(false);
+    gaps_.disconnected();
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        is_lost_ = true;
+    }
+    watch_cv_.notify_all();
+}
+
+bool Device::recover_() {
+    attempts_++;
+    const auto found = locator_ ? locator_(info_.serial, kLocateTimeoutMs) : std::nullopt;
+    if (!found.has_value()) {
+        return false;
+    }
+
+    std::lock_guard<std::shared_mutex> lock(device_mutex_);
+    if (arena_device_ != nullptr) {
+        try {
+            arena_device_->StopStream();
+        } catch (const GenICam::GenericException& e) {}  // the stream died with the link
+        try {
+            arena_system_->DestroyDevice(arena_device_);
+        } catch (const GenICam::GenericException& e) {}
+        arena_device_ = nullptr;
+    }
+
+    // a rebooted device has lost every setting, so the parameters are applied in full. they include the stream settings
+    // planned since the device was opened, which `Device::applyPacketSize()` and the like keep in them
+    arena_info_     = found.value();
+    const auto ipv4 = std::string(arena_info_.IpAddressStr().c_str());
+    publishInfo_([&ipv4](DeviceInfo& info) { info.ipv4 = ipv4; });
+    try {
+        open_();  // the profile is saved by open(), which reports its failure
+        if (is_streaming_) {
+            stream_();
+        }
+    } catch (const std::exception& e) { return false; }
+
+    reopened_ns_.store(steadyNs());
+    recovering_.store(false);
+    return true;
+}
+
+void Device::watch_() {
+    std::unique_lock<std::mutex> lock(watch_mutex_);
+    while (!stop_requested_) {
+        // the link is also checked periodically, so that a device nobody captures from is recovered as well
+        watch_cv_.wait_for(lock, std::chrono::milliseconds(kWatchIntervalMs),
+                           [this]() { return stop_requested_ || is_lost_; });
+        if (stop_requested_) {
+            break;
+        }
+        if (!is_lost_) {
+            lock.unlock();
+            const bool is_connected = isConnected();
+            if (!is_connected) {
+                lose_();
+            }
+            lock.lock();
+            continue;
+        }
+
+        lock.unlock();
+        const bool is_recovered = recover_();
+        lock.lock();
+        if (is_recovered) {
+            is_lost_ = false;
+            watch_cv_.notify_all();  // wakes up captures waiting for the recovery
+        } else {
+            watch_cv_.wait_for(lock, std::chrono::milliseconds(kWatchIntervalMs), [this]() { return stop_requested_; });
+        }
+    }
+}
+
+void Device::stopWatching_() {
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        stop_requested_ = true;
+    }
+    watch_cv_.notify_all();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
 }
 
 void Device::configurePersistentIpAddress(const std::string& ipv4, const std::string& subnet) {
@@ -127,26 +505,127 @@ void Device::configurePersistentIpAddress(const std::string& ipv4, const std::st
     config_->setGevPersistentARPConflictDetectionEnable(false);
 }
 
+DeviceParameters Device::profileParams_() const {
+    auto param = param_;
+    if (!param.trigger_group.empty() && resolver_) {
+        param.action_group_mask = resolver_(param.trigger_group);  // groups may be assigned other bits on every run
+    }
+    return param;
+}
+
+std::filesystem::path Device::profilePath_() const {
+    return std::filesystem::path(param_.profile_directory) / (info_.serial + ".profile");
+}
+
+bool Device::loadProfile_() {
+    if (param_.profile_user_set.empty() || info_.serial.empty()) {
+        return false;
+    }
+    try {
+        if (profile::hashOf(profile::load(profilePath_())) != profile::hashOf(profileParams_())) {
+            return false;  // saved from other parameters
+        }
+        config_->setUserSetSelector(param_.profile_user_set.c_str());
+        config_->executeUserSetLoad();
+        if (!isProfileLoaded_()) {
+            return false;
+        }
+
+        // the stream channel of the host and its destination are not part of user sets
+        config_->setGevSCDA(param_.gev_scda.c_str());
+        applyStreamParams_();
+    } catch (const exception::GenericException& e) {
+        return false;  // never saved, or saved by another version
+    } catch (const exception::InvalidConfigValue& e) { return false; }
+    return true;
+}
+
+bool Device::isProfileLoaded_() const {
+    // the file only tells what this host saved. the device may have been reset or swapped, or another host may have
+    // saved other settings into the user set since, so the key parameters are read back before the set is trusted
+    if (config_->getUserSetDefault() != param_.profile_user_set) {
+        return false;
+    }
+    if (config_->getWidth() != clampedSize(param_.width, config_->getWidthMax()) ||
+        config_->getHeight() != clampedSize(param_.height, config_->getHeightMax())) {
+        return false;
+    }
+    if (!param_.pixel_format.empty() && config_->getPixelFormat() != param_.pixel_format) {
+        return false;
+    }
+    if (config_->getTriggerMode() != nameOf(param_.trigger_mode)) {
+        return false;
+    }
+    const bool enable_rate = ((param_.acquisition_frame_rate > 0.0) && (param_.trigger_mode != Switch::ON));
+    return config_->getAcquisitionFrameRateEnable() == enable_rate;
+}
+
+void Device::saveProfile_() {
+    if (param_.profile_user_set.empty() || info_.serial.empty()) {
+        return;
+    }
+    try {
+        config_->setUserSetSelector(param_.profile_user_set.c_str());
+        config_->executeUserSetSave();
+        config_->setUserSetDefault(param_.profile_user_set.c_str());
+        profile::save(profilePath_(), profileParams_());  // written last, so that it only matches a complete save
+    } catch (const std::exception& e) {
+        std::error_code error;
+        std::filesystem::remove(profilePath_(), error);  // a stale file would load the user set saved in part
+        throw exception::GenericException("failed to save the profile of " + info_.serial + ": " + e.what());
+    }
+}
+
+void Device::applyStreamParams_() {
+    config_->setStreamAutoNegotiatePacketSize(param_.stream_auto_negotiate_packet_size);
+    config_->setStreamBufferHandlingMode(param_.stream_buffer_handling_mode);
+    config_->setStreamMulticastEnable(param_.stream_multicast_enable);
+    config_->setStreamPacketResendEnable(param_.stream_packet_resend_enable);
+}
+
+void Device::applyModelParams_(Config& /*config*/, const DeviceParameters& /*param*/) {}
+
+PixelFormat Device::pixelFormatOf_(const uint64_t pfnc) const {
+    return pixelFormatOf(pfnc);
+}
+
+void Device::startTransfer_(Arena::IDevice* /*device*/) {}
+
+void Device::stopTransfer_(Arena::IDevice* /*device*/) {}
+
 void Device::applyParamsOnDevice_() {
     try {
         config_->setActionDeviceKey(param_.action_device_key);
         config_->setActionGroupKey(param_.action_group_key);
-        config_->setActionGroupMask(param_.action_group_mask);
+        if (!param_.trigger_group.empty() && resolver_) {
+            config_->setActionGroupMask(resolver_(param_.trigger_group));
+        } else {
+            config_->setActionGroupMask(param_.action_group_mask);
+        }
         config_->setActionSelector(param_.action_selector);
-        config_->setActionUnconditionalMode(param_.action_unconditional_mode.c_str());
+        config_->setActionUnconditionalMode(param_.action_unconditional_mode);
 
-        config_->setAcquisitionMode(param_.acquisition_mode.c_str());
-        config_->setAcquisitionStartMode(param_.acquisition_start_mode.c_str());
+        config_->setAcquisitionMode(param_.acquisition_mode);
+        config_->setAcquisitionStartMode(param_.acquisition_start_mode);
 
-        config_->setBinningSelector(param_.binning_selector.c_str());
-        if (config_->getBinningSelector() == "Digital") {
+        // the parameters were accepted once set, so they are not read back from the device
+        config_->setBinningSelector(param_.binning_selector);
+        if (param_.binning_selector == BinningSelector::DIGITAL) {
             config_->setBinningHorizontal(param_.binning_horizontal);
-            config_->setBinningHorizontalMode(param_.binning_horizontal_mode.c_str());
+            config_->setBinningHorizontalMode(param_.binning_horizontal_mode);
             config_->setBinningVertical(param_.binning_vertical);
-            config_->setBinningVerticalMode(param_.binning_vertical_mode.c_str());
+            config_->setBinningVerticalMode(param_.binning_vertical_mode);
+        }
+
+        config_->setChunkModeActive(param_.chunk_mode_active);
+        if (param_.chunk_mode_active) {
+            for (const auto& chunk : param_.chunk_enable) {
+                config_->setChunkSelector(chunk.c_str());
+                config_->setChunkEnable(true);
+            }
         }
 
-        config_->setGainAuto(param_.gain_auto.c_str());
+        config_->setGainAuto(param_.gain_auto);
         config_->setGevSCDA(param_.gev_scda.c_str());
 
         if (param_.gev_current_ip_configuration_dhcp) {
@@ -154,70 +633,40 @@ void Device::applyParamsOnDevice_() {
             config_->setGevCurrentIPConfigurationPersistentIP(false);
         }
 
-        const auto max_w = config_->getWidthMax();
-        const auto w     = ((param_.width <= 0) || (param_.width >= max_w)) ? max_w : param_.width;
-        config_->setWidth(w);
-
-        const auto max_h = config_->getHeightMax();
-        const auto h     = ((param_.height <= 0) || (param_.height >= max_h)) ? max_h : param_.height;
-        config_->setHeight(h);
+        config_->setWidth(clampedSize(param_.width, config_->getWidthMax()));
+        config_->setHeight(clampedSize(param_.height, config_->getHeightMax()));
 
         config_->setPixelFormat(param_.pixel_format.c_str());
         config_->setPtpEnable(param_.ptp_enable);
         config_->setPtpSlaveOnly(param_.ptp_slave_only);
 
-        config_->setStreamAutoNegotiatePacketSize(param_.stream_auto_negotiate_packet_size);
-        config_->setStreamBufferHandlingMode(param_.stream_buffer_handling_mode.c_str());
-        config_->setStreamMulticastEnable(param_.stream_multicast_enable);
-        config_->setStreamPacketResendEnable(param_.stream_packet_resend_enable);
-        config_->setTransferControlMode(param_.transfer_control_mode.c_str());
+        applyStreamParams_();
+        if (param_.stream_packet_size > 0) {
+            config_->setGevSCPSPacketSize(param_.stream_packet_size);
+            config_->setGevSCPD(param_.stream_packet_delay);
+        }
+        config_->setTransferControlMode(param_.transfer_control_mode);
         config_->setTransferSelector("Stream0");
 
-        config_->setTriggerMode(param_.trigger_mode.c_str());
-        if (config_->getTriggerMode() == "On") {
-            config_->setTriggerActivation(param_.trigger_activation.c_str());
+        config_->setTriggerMode(param_.trigger_mode);
+        if (param_.trigger_mode == Switch::ON) {
+            config_->setTriggerActivation(param_.trigger_activation);
             config_->setTriggerDelay(param_.trigger_delay);
-            config_->setTriggerOverlap(param_.trigger_overlap.c_str());
-            if (config_->getTriggerOverlap() == "Off") {
-                config_->setTriggerLatency(param_.trigger_latency.c_str());
+            config_->setTriggerOverlap(param_.trigger_overlap);
+            if (param_.trigger_overlap == TriggerOverlap::OFF) {
+                config_->setTriggerLatency(param_.trigger_latency);
             }
-            config_->setTriggerSelector(param_.trigger_selector.c_str());
+            config_->setTriggerSelector(param_.trigger_selector);
             config_->setTriggerSource(param_.trigger_source.c_str());
         }
 
-        const bool enable_rate = ((param_.acquisition_frame_rate > 0.0) && (config_->getTriggerMode() != "On"));
+        const bool enable_rate = ((param_.acquisition_frame_rate > 0.0) && (param_.trigger_mode != Switch::ON));
         config_->setAcquisitionFrameRateEnable(enable_rate);
-        if (config_->getAcquisitionFrameRateEnable()) {
+        if (enable_rate) {
             config_->setAcquisitionFrameRate(param_.acquisition_frame_rate);
         }
 
-        switch (info_.device_type) {
-        case DeviceType::RGB_CAMERA:
-            config_->setExposureAuto(param_.exposure_auto.c_str());
-            if (config_->getExposureAuto() == "Continuous") {
-                config_->setExposureAutoLimitAuto(param_.exposure_auto_limit_auto.c_str());
-                if ((config_->getExposureAutoLimitAuto()) == "Off") {
-                    config_->setExposureAutoLowerLimit(param_.exposure_auto_lower_limit);
-                    config_->setExposureAutoUpperLimit(param_.exposure_auto_upper_limit);
-                }
-            } else if (config_->getExposureAuto() == "Off") {
-                config_->setExposureTime(param_.exposure_time);
-            }
-
-            config_->setReverseX(param_.reverse_x);
-            config_->setReverseY(param_.reverse_y);
-
-            config_->setTargetBrightness(param_.target_brightness);
-            config_->setTransferOperationMode(param_.transfer_operation_mode.c_str());
-            break;
-        case DeviceType::TOF_CAMERA:
-            config_->setScan3dModeSelector("Processed");
-            config_->setConversionGain(param_.conversion_gain.c_str());
-            break;
-
-        default:
-            break;
-        }
+        applyModelParams_(*config_, param_);
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
 }
 
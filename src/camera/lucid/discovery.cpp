@@ -0,0 +1,130 @@
+#include <chrono>
+#include <set>
+#include <utility>
+
+#include "camera/exception.h"
+#include "camera/lucid/discovery.hpp"
+
+namespace camera {
+namespace lucid {
+
+namespace {
+bool isAddressChanged(const DeviceInfo& previous, const DeviceInfo& current) {
+    return previous.ipv4 != current.ipv4 || previous.subnet_mask != current.subnet_mask
+        || previous.host_ipv4 != current.host_ipv4;
+}
+}  // namespace
+
+Discovery::Discovery(System& system, const Options& options, Callbacks callbacks)
+    : system_(system)
+    , options_(options)
+    , callbacks_(std::move(callbacks)) {
+    options_.departure_scans = (options_.departure_scans > 0) ? options_.departure_scans : 1;
+    worker_                  = std::thread(&Discovery::run_, this);
+}
+
+Discovery::~Discovery() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    stop_cv_.notify_all();
+    worker_.join();
+}
+
+std::map<std::string, DeviceInfo> Discovery::devices() const {
+    std::lock_guard<std::mutex>       lock(mutex_);
+    std::map<std::string, DeviceInfo> devices;
+    for (const auto& [serial, entry] : table_) {
+        devices.emplace(serial, entry.info);
+    }
+    return devices;
+}
+
+std::optional<DeviceInfo> Discovery::find(const std::string& serial) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto                  found = table_.find(serial);
+    return (found != table_.end()) ? std::optional<DeviceInfo>(found->second.info) : std::nullopt;
+}
+
+std::optional<DeviceInfo> Discovery::waitFor(const std::string& serial, const int64_t timeout_ms) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                         [&]() { return stop_requested_ || table_.count(serial) > 0; });
+    const auto found = table_.find(serial);
+    return (found != table_.end()) ? std::optional<DeviceInfo>(found->second.info) : std::nullopt;
+}
+
+uint64_t Discovery::scans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scans_;
+}
+
+void Discovery::update_(const std::vector<DeviceInfo>& scanned) {
+    std::vector<DeviceInfo>                        arrived;
+    std::vector<DeviceInfo>                        departed;
+    std::vector<std::pair<DeviceInfo, DeviceInfo>> changed;
+    std::set<std::string>                          present;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& info : scanned) {
+            present.insert(info.serial);
+            auto found = table_.find(info.serial);
+            if (found == table_.end()) {
+                table_.emplace(info.serial, Entry{info, 0});
+                arrived.push_back(info);
+                continue;
+            }
+            if (isAddressChanged(found->second.info, info)) {
+                changed.emplace_back(found->second.info, info);
+            }
+            found->second = Entry{info, 0};
+        }
+        for (auto it = table_.begin(); it != table_.end();) {
+            if (present.count(it->first) == 0 && ++it->second.missed >= options_.departure_scans) {
+                departed.push_back(it->second.info);
+                it = table_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        scans_++;
+    }
+    changed_cv_.notify_all();
+
+    // callbacks run outside of the lock, so that they may query the table
+    for (const auto& info : departed) {
+        if (callbacks_.departure) {
+            callbacks_.departure(info);
+        }
+    }
+    for (const auto& [previous, current] : changed) {
+        if (callbacks_.address_change) {
+            callbacks_.address_change(previous, current);
+        }
+    }
+    for (const auto& info : arrived) {
+        if (callbacks_.arrival) {
+            callbacks_.arrival(info);
+        }
+    }
+}
+
+void Discovery::run_() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_requested_) {
+        lock.unlock();
+        try {
+            update_(system_.scan(options_.scan_timeout_ms));
+        } catch (const exception::DeviceNotFound& e) {
+            update_({});
+        } catch (const exception::GenericException& e) {
+            // a failed scan says nothing about the devices, so the table is kept as is
+        }
+        lock.lock();
+        stop_cv_.wait_for(lock, std::chrono::milliseconds(options_.interval_ms), [this]() { return stop_requested_; });
+    }
+}
+
+}  // namespace lucid
+}  // namespace camera
@@ -1,71 +1,262 @@
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <unordered_set>
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
 #include "camera/lucid/network.hpp"
 #include "camera/exception.h"
+#include "camera/lucid/spec.h"
+
+#include "camera/lucid/utils.h"
 
 namespace camera {
 namespace lucid {
 namespace network {
 
 namespace {
-uint32_t generateIpAddress(uint32_t ip_address, uint32_t subnet_mask) {
-    uint32_t new_ip_address(0);
-    uint32_t rand_num = static_cast<uint32_t>(std::rand()) & (~subnet_mask);
-    while (rand_num == 0 || rand_num == 0xFFFFFFFF || new_ip_address == 0 || new_ip_address == ip_address) {
-        rand_num       = static_cast<uint32_t>(std::rand()) & (~subnet_mask);
-        new_ip_address = (ip_address & subnet_mask) | rand_num;
-    }
-    return new_ip_address;
+constexpr int64_t kPacketHeaderBytes     = 36;  // IP, UDP and GVSP headers, which count towards the packet size
+constexpr int64_t kEthernetOverheadBytes = 38;  // frame header, FCS, preamble and inter-frame gap
+constexpr int64_t kFramingPackets        = 2;   // GVSP leader and trailer
+
+uint32_t hashOf(const uint64_t mac) {
+    uint32_t hash = 2166136261U;  // 32-bit FNV-1a over the six bytes of the MAC
+    for (int shift = 40; shift >= 0; shift -= 8) {
+        hash = (hash ^ static_cast<uint32_t>((mac >> shift) & 0xFF)) * 16777619U;
+    }
+    return hash;
 }
+}  // namespace
 
-bool containDuplicate(std::vector<uint32_t>& values, const uint32_t value) {
-    for (const auto& v : values) {
-        if (v == value) {
-            return true;
+std::vector<Assignment> planAddresses(const uint32_t host_address, const uint32_t subnet_mask,
+                                      const std::vector<Assignment>& devices, const std::vector<uint32_t>& reserved) {
+    const uint32_t net_address = host_address & subnet_mask;
+    const uint32_t host_bits   = ~subnet_mask;
+    std::unordered_set<uint32_t> used{host_address};
+    std::vector<Assignment>      plan(devices);
+    for (const auto address : reserved) {
+        if ((address & subnet_mask) == net_address) {
+            used.insert(address);
         }
     }
-    return false;
+    // the network and broadcast addresses are not usable
+    if (host_bits < 3 || devices.size() + used.size() > host_bits - 1) {
+        throw exception::InvalidConfigValue("subnet is too small for the devices");
+    }
+
+    // devices are visited in the order of their MACs, so that collisions are resolved the same way on every run
+    std::vector<std::size_t> order(plan.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](const std::size_t a, const std::size_t b) { return plan[a].mac < plan[b].mac; });
+
+    std::vector<std::size_t> pending;
+    for (const auto i : order) {
+        auto&      device       = plan[i];
+        const auto host_part    = device.ip_address & host_bits;
+        const auto is_on_subnet = (device.ip_address & subnet_mask) == net_address && device.subnet_mask == subnet_mask;
+        if (is_on_subnet && host_part != 0 && host_part != host_bits && used.insert(device.ip_address).second) {
+            device.forced = false;
+            continue;
+        }
+        pending.push_back(i);
+    }
+
+    const uint32_t usable = host_bits - 1;  // host parts in [1, host_bits - 1]
+    for (const auto i : pending) {
+        auto&    device    = plan[i];
+        uint32_t host_part = hashOf(device.mac) % usable + 1;
+        while (used.count(net_address | host_part) > 0) {
+            host_part = host_part % usable + 1;
+        }
+        device.ip_address  = net_address | host_part;
+        device.subnet_mask = subnet_mask;
+        device.forced      = true;
+        used.insert(device.ip_address);
+    }
+    return plan;
+}
+
+std::vector<Assignment> planSubnets(const std::vector<Subnet>& subnets) {
+    std::vector<uint32_t> hosts;
+    for (const auto& subnet : subnets) {
+        hosts.push_back(subnet.host_address);
+    }
+
+    // addresses the devices of each interface keep when planned on their own, which the interfaces before it avoid
+    std::vector<std::vector<uint32_t>> kept(subnets.size());
+    for (std::size_t i = 0; i < subnets.size(); i++) {
+        const auto& subnet = subnets[i];
+        for (const auto& device : planAddresses(subnet.host_address, subnet.subnet_mask, subnet.devices, hosts)) {
+            if (!device.forced) {
+                kept[i].push_back(device.ip_address);
+            }
+        }
+    }
+
+    std::vector<Assignment> plan;
+    for (std::size_t i = 0; i < subnets.size(); i++) {
+        auto taken = hosts;
+        for (const auto& device : plan) {
+            taken.push_back(device.ip_address);
+        }
+        for (std::size_t j = i + 1; j < subnets.size(); j++) {
+            taken.insert(taken.end(), kept[j].begin(), kept[j].end());
+        }
+        const auto& subnet = subnets[i];
+        for (const auto& device : planAddresses(subnet.host_address, subnet.subnet_mask, subnet.devices, taken)) {
+            plan.push_back(device);
+        }
+    }
+    return plan;
 }
-}  // namespace
 
 void autoConfigureIP(Arena::ISystem* sys, std::vector<Arena::DeviceInfo>& device_infos) {
-    std::vector<uint32_t> ip_addrs;
+    std::map<uint32_t, Subnet> interfaces;  // by host address
     try {
-        auto interface_node_map = sys->GetTLInterfaceNodeMap(device_infos[0]);
-        if (!interface_node_map) {
-            return;
+        for (auto& info : device_infos) {
+            auto interface_node_map = sys->GetTLInterfaceNodeMap(info);
+            if (!interface_node_map) {
+                continue;
+            }
+            GenApi::CIntegerPtr node_ip_addr  = interface_node_map->GetNode("GevInterfaceSubnetIPAddress");
+            GenApi::CIntegerPtr node_sub_mask = interface_node_map->GetNode("GevInterfaceSubnetMask");
+
+            auto& interface        = interfaces[static_cast<uint32_t>(node_ip_addr->GetValue())];
+            interface.host_address = static_cast<uint32_t>(node_ip_addr->GetValue());
+            interface.subnet_mask  = static_cast<uint32_t>(node_sub_mask->GetValue());
+            interface.devices.push_back(Assignment{info.MacAddress(), static_cast<uint32_t>(info.IpAddress()),
+                                                   static_cast<uint32_t>(info.SubnetMask()), false});
         }
+    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+
+    std::vector<Subnet> subnets;
+    for (auto& [host_address, interface] : interfaces) {
+        subnets.push_back(std::move(interface));
+    }
+    const auto plan = planSubnets(subnets);
 
-        GenApi::CIntegerPtr node_ip_addr  = interface_node_map->GetNode("GevInterfaceSubnetIPAddress");
-        GenApi::CIntegerPtr node_sub_mask = interface_node_map->GetNode("GevInterfaceSubnetMask");
+    // the system is not known to be safe to call from several threads, so the devices are forced one after another.
+    // a failure does not keep the others from being forced
+    std::string error;
+    for (const auto& device : plan) {
+        if (!device.forced) {
+            continue;
+        }
+        try {
+            sys->ForceIp(device.mac, device.ip_address, device.subnet_mask, 0);
+        } catch (const GenICam::GenericException& e) {
+            error = error.empty() ? e.what() : error;
+        } catch (const std::exception& e) { error = error.empty() ? e.what() : error; }
+    }
+    if (!error.empty()) {
+        throw exception::GenericException(error);
+    }
+}
 
-        // gev_sub_mask = static_cast<uint32_t>(node_sub_mask->GetValue(true, true));
-        uint32_t gev_ip_addr  = static_cast<uint32_t>(node_ip_addr->GetValue());
-        uint32_t gev_sub_mask = 0xffffff00;
-        uint32_t gev_net_addr = gev_ip_addr & gev_sub_mask;
+std::string hostAddressOf(Arena::ISystem* sys, const Arena::DeviceInfo& device_info) {
+    try {
+        auto interface_node_map = sys->GetTLInterfaceNodeMap(device_info);
+        if (!interface_node_map) {
+            return "";
+        }
+        GenApi::CIntegerPtr node_ip_addr = interface_node_map->GetNode("GevInterfaceSubnetIPAddress");
+        if (!GenApi::IsReadable(node_ip_addr)) {
+            return "";
+        }
 
-        ip_addrs.push_back(gev_ip_addr);
+        in_addr addr{};
+        addr.s_addr = htonl(static_cast<uint32_t>(node_ip_addr->GetValue()));
 
-        for (auto& info : device_infos) {
-            const uint32_t dev_ip_addr  = info.IpAddress();
-            const uint32_t dev_sub_mask = info.SubnetMask();
-            const uint32_t dev_net_addr = dev_ip_addr & dev_sub_mask;
+        char buffer[INET_ADDRSTRLEN] = {};
+        return (inet_ntop(AF_INET, &addr, buffer, sizeof(buffer)) != nullptr) ? std::string(buffer) : "";
+    } catch (const GenICam::GenericException& e) { return ""; }
+}
 
-            const auto is_new_addr_needed = ((gev_net_addr != dev_net_addr) || (gev_ip_addr == dev_ip_addr));
-            if (!is_new_addr_needed) {
-                ip_addrs.push_back(dev_ip_addr);
-                continue;
-            }
+std::string accessStatusOf(Arena::ISystem* sys, const Arena::DeviceInfo& device_info) {
+    try {
+        auto interface_node_map = sys->GetTLInterfaceNodeMap(device_info);
+        if (!interface_node_map) {
+            return "";
+        }
+        GenApi::CIntegerPtr     node_selector = interface_node_map->GetNode("DeviceSelector");
+        GenApi::CStringPtr      node_serial   = interface_node_map->GetNode("DeviceSerialNumber");
+        GenApi::CEnumerationPtr node_status   = interface_node_map->GetNode("DeviceAccessStatus");
+        if (!GenApi::IsWritable(node_selector) || !GenApi::IsReadable(node_serial)) {
+            return "";
+        }
 
-            uint64_t mac_addr    = info.MacAddress();
-            uint32_t new_ip_addr = gev_ip_addr;
-            while (new_ip_addr == gev_ip_addr || containDuplicate(ip_addrs, new_ip_addr)) {
-                new_ip_addr = generateIpAddress(gev_ip_addr, gev_sub_mask);
+        // the interface lists every device it reaches, and its nodes describe the selected one
+        const auto serial = device_info.SerialNumber();
+        for (auto index = node_selector->GetMin(); index <= node_selector->GetMax(); index++) {
+            node_selector->SetValue(index);
+            if (node_serial->GetValue() == serial) {
+                return GenApi::IsReadable(node_status) ? std::string(node_status->ToString().c_str()) : "";
             }
+        }
+    } catch (const GenICam::GenericException& e) {}
+    return "";
+}
 
-            ip_addrs.push_back(new_ip_addr);
+int64_t hostMtuOf(const std::string& host_ipv4) {
+    in_addr target{};
+    if (inet_aton(host_ipv4.c_str(), &target) == 0) {
+        return 0;
+    }
 
-            sys->ForceIp(mac_addr, new_ip_addr, gev_sub_mask, 0);
+    ifaddrs* addrs = nullptr;
+    if (getifaddrs(&addrs) != 0) {
+        return 0;
+    }
+    std::string name;
+    for (ifaddrs* it = addrs; it != nullptr; it = it->ifa_next) {
+        if (it->ifa_addr == nullptr || it->ifa_addr->sa_family != AF_INET) {
+            continue;
         }
-    } catch (const exception::GenericException& e) { throw exception::GenericException(); }
+        if (reinterpret_cast<const sockaddr_in*>(it->ifa_addr)->sin_addr.s_addr == target.s_addr) {
+            name = it->ifa_name;
+            break;
+        }
+    }
+    freeifaddrs(addrs);
+    if (name.empty()) {
+        return 0;
+    }
+
+    const int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    ifreq request{};
+    std::strncpy(request.ifr_name, name.c_str(), IFNAMSIZ - 1);
+    const auto mtu = (ioctl(fd, SIOCGIFMTU, &request) == 0) ? request.ifr_mtu : 0;
+    close(fd);
+    return mtu;
+}
+
+int64_t wireBytesOf(const int64_t payload_bytes, const int64_t packet_size) {
+    return payload_bytes + packetsOf(payload_bytes, packet_size) * (kPacketHeaderBytes + kEthernetOverheadBytes);
+}
+
+int64_t packetsOf(const int64_t payload_bytes, const int64_t packet_size) {
+    const auto data_per_packet = std::max<int64_t>(packet_size - kPacketHeaderBytes, 1);
+    return (payload_bytes + data_per_packet - 1) / data_per_packet + kFramingPackets;
+}
+
+int64_t wirePacketBytesOf(const int64_t packet_size) {
+    return packet_size + kEthernetOverheadBytes;
+}
+
+int64_t linkSpeedOf(const Config& config, const DeviceInfo& info) {
+    try {
+        return config.getDeviceLinkSpeed();
+    } catch (const exception::InvalidConfigValue& e) { return specOf(utils::parseModel(info.model)).link_speed; }
 }
 
 }  // namespace network
@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include <time.h>
+
+#include "camera/exception.h"
+#include "camera/lucid/device.hpp"
+#include "camera/lucid/ptp.hpp"
+
+namespace camera {
+namespace lucid {
+
+namespace {
+int64_t clockNs(const clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+uint64_t convert(const int64_t from_ref, const int64_t to_ref, const double rate, const uint64_t stamp) {
+    const auto elapsed = static_cast<double>(static_cast<int64_t>(stamp) - from_ref);
+    return static_cast<uint64_t>(to_ref + static_cast<int64_t>(std::llround(rate * elapsed)));
+}
+}  // namespace
+
+PtpMonitor::PtpMonitor(const std::vector<std::shared_ptr<IDevice>>& devices, const Options& options)
+    : options_(options) {
+    options_.window = (options_.window > 0) ? options_.window : 1;
+    for (const auto& device : devices) {
+        Channel channel;
+        channel.device = std::dynamic_pointer_cast<Device>(device);
+        channels_.emplace_back(std::move(channel));
+    }
+    worker_ = std::thread(&PtpMonitor::run_, this);
+}
+
+PtpMonitor::~PtpMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+PtpMonitor::Sync PtpMonitor::sync(const std::size_t device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channels_.at(device).sync;
+}
+
+uint64_t PtpMonitor::toRealtime(const std::size_t device, const uint64_t stamp) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto&                 mapping = channels_.at(device).mapping;
+    return mapping.valid ? convert(mapping.device_ns, mapping.realtime_ns, mapping.realtime_rate, stamp) : stamp;
+}
+
+uint64_t PtpMonitor::toMonotonic(const std::size_t device, const uint64_t stamp) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto&                 mapping = channels_.at(device).mapping;
+    return mapping.valid ? convert(mapping.device_ns, mapping.monotonic_ns, mapping.monotonic_rate, stamp) : stamp;
+}
+
+void PtpMonitor::sample_(Channel& channel) {
+    const auto device = channel.device.lock();
+    if (device == nullptr) {
+        return;  // destroyed, or not a lucid device
+    }
+
+    std::string status;
+    int64_t     offset = 0;
+    Latch       latch;
+    bool        is_read = true;
+    // the configuration is looked up on every sample, since a recovery replaces it together with the device
+    const bool is_opened = device->withConfig([&](Config& config) {
+        try {
+            status = config.getPtpStatus();
+            offset = config.getPtpOffsetFromMaster();
+
+            // host clocks are taken around the latch, so that the midpoint halves the uncertainty of the round trip
+            const auto realtime_before  = clockNs(CLOCK_REALTIME);
+            const auto monotonic_before = clockNs(CLOCK_MONOTONIC);
+            config.executeTimestampLatch();
+            const auto monotonic_after = clockNs(CLOCK_MONOTONIC);
+            const auto realtime_after  = clockNs(CLOCK_REALTIME);
+
+            latch.device_ns    = config.getTimestampLatchValue();
+            latch.realtime_ns  = realtime_before + (realtime_after - realtime_before) / 2;
+            latch.monotonic_ns = monotonic_before + (monotonic_after - monotonic_before) / 2;
+        } catch (const exception::InvalidConfigValue& e) { is_read = false; }
+    });
+    if (!is_opened) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_read) {
+        channel.sync.failures++;
+        return;
+    }
+    // the device clock is stepped when it locks to another master, which no fit across the step can follow
+    const bool is_stepped = channel.sync.samples > 0 &&
+                            (status != channel.sync.status ||
+                             std::abs(offset - channel.sync.offset_from_master_ns) > options_.max_offset_ns);
+    if (is_stepped) {
+        channel.latches.clear();
+        channel.mapping = Mapping();
+    }
+    channel.sync.status                = status;
+    channel.sync.offset_from_master_ns = offset;
+    channel.sync.samples++;
+    channel.sync.updated_ns = static_cast<uint64_t>(latch.realtime_ns);
+
+    channel.latches.push_back(latch);
+    while (channel.latches.size() > options_.window) {
+        channel.latches.pop_front();
+    }
+    fit_(channel);
+}
+
+void PtpMonitor::fit_(Channel& channel) {
+    const auto& latches = channel.latches;
+    const auto& origin  = latches.front();  // differences from the first latch keep the sums within double precision
+    const auto  count   = static_cast<double>(latches.size());
+
+    double mean_device    = 0.0;
+    double mean_realtime  = 0.0;
+    double mean_monotonic = 0.0;
+    for (const auto& latch : latches) {
+        mean_device += static_cast<double>(latch.device_ns - origin.device_ns) / count;
+        mean_realtime += static_cast<double>(latch.realtime_ns - origin.realtime_ns) / count;
+        mean_monotonic += static_cast<double>(latch.monotonic_ns - origin.monotonic_ns) / count;
+    }
+
+    double var_device    = 0.0;
+    double cov_realtime  = 0.0;
+    double cov_monotonic = 0.0;
+    for (const auto& latch : latches) {
+        const double device = static_cast<double>(latch.device_ns - origin.device_ns) - mean_device;
+        var_device += device * device;
+        cov_realtime += device * (static_cast<double>(latch.realtime_ns - origin.realtime_ns) - mean_realtime);
+        cov_monotonic += device * (static_cast<double>(latch.monotonic_ns - origin.monotonic_ns) - mean_monotonic);
+    }
+
+    Mapping mapping;
+    mapping.valid          = true;
+    mapping.device_ns      = origin.device_ns + static_cast<int64_t>(std::llround(mean_device));
+    mapping.realtime_ns    = origin.realtime_ns + static_cast<int64_t>(std::llround(mean_realtime));
+    mapping.monotonic_ns   = origin.monotonic_ns + static_cast<int64_t>(std::llround(mean_monotonic));
+    mapping.realtime_rate  = (var_device > 0.0) ? cov_realtime / var_device : 1.0;
+    mapping.monotonic_rate = (var_device > 0.0) ? cov_monotonic / var_device : 1.0;
+
+    double squared = 0.0;
+    for (const auto& latch : latches) {
+        const auto   predicted = convert(mapping.device_ns, mapping.realtime_ns, mapping.realtime_rate,
+                                         static_cast<uint64_t>(latch.device_ns));
+        const double error     = static_cast<double>(static_cast<int64_t>(predicted) - latch.realtime_ns);
+        squared += error * error;
+    }
+
+    channel.mapping          = mapping;
+    channel.sync.drift_ppm   = (1.0 / mapping.realtime_rate - 1.0) * 1e6;
+    channel.sync.residual_ns = std::sqrt(squared / count);
+}
+
+void PtpMonitor::run_() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_requested_) {
+        lock.unlock();
+        for (auto& channel : channels_) {
+            sample_(channel);
+        }
+        lock.lock();
+        cv_.wait_for(lock, std::chrono::milliseconds(options_.interval_ms), [this]() { return stop_requested_; });
+    }
+}
+
+}  // namespace lucid
+}  // namespace camera
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "camera/exception.h"
+#include "camera/lucid/device.hpp"
+#include "camera/lucid/scheduler.hpp"
+#include "camera/lucid/system.hpp"
+
+namespace camera {
+namespace lucid {
+
+namespace {
+int64_t realtimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+ActionScheduler::ActionScheduler(ISystem& system, const std::vector<std::shared_ptr<IDevice>>& devices,
+                                 const Options& options, Clock clock)
+    : system_(system)
+    , options_(options)
+    , clock_(clock ? std::move(clock) : Clock(realtimeNs)) {
+    if (options_.period_ns <= 0) {
+        throw exception::InvalidConfigValue("action command period must be positive");
+    }
+    if (!options_.groups.empty() && dynamic_cast<System*>(&system_) == nullptr) {
+        throw exception::InvalidConfigValue("trigger groups require a lucid system");
+    }
+    for (const auto& group : options_.groups) {
+        static_cast<void>(static_cast<System&>(system_).triggerGroupMask(group));  // allocated before the worker fires
+    }
+
+    for (const auto& device : devices) {
+        const auto lucid_device = std::dynamic_pointer_cast<Device>(device);
+        if (lucid_device == nullptr || lucid_device->getConfig() == nullptr) {
+            continue;  // not opened
+        }
+        try {
+            const auto depth = lucid_device->getConfig()->getActionQueueSize();
+            queue_depth_     = (queue_depth_ == 0) ? depth : std::min(queue_depth_, depth);
+        } catch (const exception::InvalidConfigValue& e) {
+            continue;  // not supported by the model
+        }
+    }
+    if (queue_depth_ > 0) {
+        options_.lead_periods = std::min(options_.lead_periods, static_cast<std::size_t>(queue_depth_));
+    }
+    options_.lead_periods = std::max<std::size_t>(options_.lead_periods, 1);
+}
+
+ActionScheduler::~ActionScheduler() {
+    stop();
+}
+
+void ActionScheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker_.joinable()) {
+        return;
+    }
+
+    const auto lead = static_cast<int64_t>(options_.lead_periods) * options_.period_ns;
+    const auto now  = clock_();
+    if (origin_ns_.load() == 0) {
+        origin_ns_.store((options_.start_ns > 0) ? options_.start_ns
+                                                 : ((now + lead) / options_.period_ns + 1) * options_.period_ns);
+    }
+    // resumes with the first command which can still be sent ahead of its execute time
+    const auto origin = origin_ns_.load();
+    const auto ahead  = now + lead - origin;
+    next_index_       = (ahead < 0) ? 0 : static_cast<uint64_t>(ahead / options_.period_ns + 1);
+
+    stop_requested_ = false;
+    worker_         = std::thread(&ActionScheduler::run_, this);
+}
+
+void ActionScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+int64_t ActionScheduler::scheduledAt(const uint64_t index) const {
+    return origin_ns_.load() + static_cast<int64_t>(index) * options_.period_ns;
+}
+
+int64_t ActionScheduler::observe(const IImage& image, const int64_t delay_ns) {
+    const auto origin = origin_ns_.load();
+    const auto stamp  = static_cast<int64_t>(image.header.stamp) - delay_ns;
+
+    // nearest command, as the stamp may fall slightly before or after its execute time
+    const auto cycles    = static_cast<double>(stamp - origin) / static_cast<double>(options_.period_ns);
+    const auto index     = static_cast<int64_t>(std::llround(cycles));
+    const auto deviation = stamp - (origin + index * options_.period_ns);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    observed_++;
+    const double delta = static_cast<double>(deviation) - mean_ns_;
+    mean_ns_ += delta / static_cast<double>(observed_);
+    m2_ += delta * (static_cast<double>(deviation) - mean_ns_);
+    max_abs_ns_ = std::max(max_abs_ns_, std::abs(deviation));
+    return deviation;
+}
+
+ActionScheduler::Stats ActionScheduler::stats() const {
+    Stats stats;
+    stats.fired         = fired_.load();
+    stats.missed        = missed_.load();
+    stats.queue_depth   = queue_depth_;
+    stats.lead_periods  = options_.lead_periods;
+    stats.last_fired_ns = last_fired_ns_.load();
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats.observed   = observed_;
+    stats.mean_ns    = mean_ns_;
+    stats.stddev_ns  = (observed_ > 1) ? std::sqrt(m2_ / static_cast<double>(observed_ - 1)) : 0.0;
+    stats.max_abs_ns = max_abs_ns_;
+    return stats;
+}
+
+void ActionScheduler::fire_(const int64_t execute_ns) {
+    if (options_.groups.empty()) {
+        system_.fireActionCommand(execute_ns);
+        return;
+    }
+    static_cast<System&>(system_).fireActionCommand(options_.groups, execute_ns);  // checked by the constructor
+}
+
+void ActionScheduler::run_() {
+    const auto lead = static_cast<int64_t>(options_.lead_periods) * options_.period_ns;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_requested_) {
+        const auto execute_ns = scheduledAt(next_index_);
+
+        // sleeps towards the absolute send time, so that late wake-ups never accumulate into drift
+        const auto remaining_ns = (execute_ns - lead) - clock_();
+        if (remaining_ns > 0) {
+            cv_.wait_for(lock, std::chrono::nanoseconds(remaining_ns), [this]() { return stop_requested_; });
+            continue;
+        }
+
+        lock.unlock();
+        if (clock_() >= execute_ns) {
+            missed_++;
+        } else {
+            try {
+                fire_(execute_ns);
+                fired_++;
+                last_fired_ns_.store(execute_ns);
+            } catch (const exception::GenericException& e) { missed_++; }
+        }
+        next_index_++;
+        lock.lock();
+    }
+}
+
+}  // namespace lucid
+}  // namespace camera
@@ -1,44 +1,104 @@
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 
 #include "camera/exception.h"
 #include "camera/lucid/spec.h"
-#include "camera/lucid/spec.hpp"
 
 namespace camera {
 namespace lucid {
 
 namespace {
 
-template<Model M>
-constexpr Spec defineRuntimeSpec() {
-    using S = SpecOf<M>;
-    return Spec{
-        S::device_type,
-        S::max_rate,
-        S::max_width,
-        S::max_height,
-    };
-}
+struct FormatSpec {
+    const char* name;
+    uint32_t    bit;
+    std::size_t bits_per_pixel;
+};
 
-const Spec UNKNOWN     = defineRuntimeSpec<Model::UNKNOWN>();
-const Spec TRI028S_C   = defineRuntimeSpec<Model::TRI028S_C>();
-const Spec PHX016S_C   = defineRuntimeSpec<Model::PHX016S_C>();
-const Spec HTP003S_001 = defineRuntimeSpec<Model::HTP003S_001>();
+constexpr std::array<FormatSpec, 15> kFormats = {{
+    {"Mono8", format::MONO8, 8},
+    {"Mono10p", format::MONO10P, 10},
+    {"Mono12p", format::MONO12P, 12},
+    {"Mono16", format::MONO16, 16},
+    {"BayerRG8", format::BAYER_RG8, 8},
+    {"BayerRG10p", format::BAYER_RG10P, 10},
+    {"BayerRG12p", format::BAYER_RG12P, 12},
+    {"BayerRG16", format::BAYER_RG16, 16},
+    {"RGB8", format::RGB8, 24},
+    {"BGR8", format::BGR8, 24},
+    {"YCbCr422_8", format::YCBCR422_8, 16},
+    {"Coord3D_C16", format::COORD3D_C16, 16},
+    {"Coord3D_ABC16", format::COORD3D_ABC16, 48},
+    {"Coord3D_ABCY16", format::COORD3D_ABCY16, 64},
+    {"Confidence16", format::CONFIDENCE16, 16},
+}};
+
+const FormatSpec* findFormat(const std::string& pixel_format) {
+    for (const auto& spec : kFormats) {
+        if (pixel_format == spec.name) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
 
 }  // namespace
 
-Spec specOf(Model model) {
-    switch (model) {
-    case Model::UNKNOWN:
-        return UNKNOWN;
-    case Model::TRI028S_C:
-        return TRI028S_C;
-    case Model::PHX016S_C:
-        return PHX016S_C;
-    case Model::HTP003S_001:
-        return HTP003S_001;
-    default:
-        return UNKNOWN;
+uint32_t formatBitOf(const std::string& pixel_format) {
+    const auto* spec = findFormat(pixel_format);
+    return (spec != nullptr) ? spec->bit : 0;
+}
+
+std::size_t bitsPerPixelOf(const std::string& pixel_format) {
+    const auto* spec = findFormat(pixel_format);
+    return (spec != nullptr) ? spec->bits_per_pixel : 0;
+}
+
+std::vector<std::size_t> frameSizesOf(const Spec& spec) {
+    std::vector<std::size_t> sizes;
+    for (const auto& format : kFormats) {
+        if ((spec.pixel_formats & format.bit) != 0) {
+            sizes.push_back(spec.max_width * spec.max_height * format.bits_per_pixel / 8);
+        }
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+void validate(const Spec& spec, const DeviceParameters& param) {
+    if (spec.device_type == DeviceType::UNDEFINED) {
+        return;  // nothing is known about the model
+    }
+    const auto format_bit = formatBitOf(param.pixel_format);
+    if (format_bit == 0) {
+        return;  // nothing is known about the format
+    }
+    if ((spec.pixel_formats & format_bit) == 0) {
+        throw exception::InvalidConfigValue("pixel_format " + param.pixel_format + " is not supported by the model");
+    }
+    // the requested image, before any clamping, must fit the largest buffer of the model
+    const auto bits_per_pixel = bitsPerPixelOf(param.pixel_format);
+    const auto request_width  = static_cast<double>((param.width > 0) ? param.width : spec.max_width);
+    const auto request_height = static_cast<double>((param.height > 0) ? param.height : spec.max_height);
+    if (request_width * request_height * bits_per_pixel / 8 > static_cast<double>(spec.max_payload_bytes)) {
+        throw exception::InvalidConfigValue("width and height of " + param.pixel_format
+                                            + " images exceed the maximal payload of the model");
+    }
+    if (param.acquisition_frame_rate <= 0.0 || param.trigger_mode == Switch::ON || spec.link_speed <= 0) {
+        return;  // the rate of the stream is not known in advance
+    }
+
+    // sizes out of range are clamped to the sensor when applied, see `DeviceParameters::width`
+    const auto width   = (param.width > 0) ? std::min<std::size_t>(param.width, spec.max_width) : spec.max_width;
+    const auto height  = (param.height > 0) ? std::min<std::size_t>(param.height, spec.max_height) : spec.max_height;
+    const auto h_bins  = static_cast<std::size_t>(std::max<int64_t>(param.binning_horizontal, 1));
+    const auto v_bins  = static_cast<std::size_t>(std::max<int64_t>(param.binning_vertical, 1));
+    const auto payload = (width / h_bins) * (height / v_bins) * bits_per_pixel / 8;
+    if (static_cast<double>(payload) * param.acquisition_frame_rate > static_cast<double>(spec.link_speed)) {
+        throw exception::InvalidConfigValue("acquisition_frame_rate of " + param.pixel_format
+                                            + " images exceeds the link speed of the model");
     }
 }
 
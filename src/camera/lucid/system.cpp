@@ -1,5 +1,10 @@
 #include <algorithm>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <shared_mutex>
 
+#include "camera/lucid/device_of.hpp"
 #include "camera/lucid/network.hpp"
 #include "camera/lucid/system.hpp"
 
@@ -8,10 +13,21 @@
 namespace camera {
 namespace lucid {
 
-System::System() {
+namespace {
+constexpr uint64_t kRetainedScans = 16;  // scans a device not created yet is remembered for after it was last found
+}  // namespace
+
+System::System()
+    : handle_(std::make_shared<Handle>()) {
+    handle_->system = this;
     try {
         arena_system_   = Arena::OpenSystem();
         arena_node_map_ = arena_system_->GetTLSystemNodeMap();
+
+        // the nodes of an action command are looked up once, so that firing only writes their values
+        action_group_mask_   = arena_node_map_->GetNode("ActionCommandGroupMask");
+        action_execute_time_ = arena_node_map_->GetNode("ActionCommandExecuteTime");
+        action_fire_         = arena_node_map_->GetNode("ActionCommandFireCommand");
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
 
     setDeviceKey(0x00000001);
@@ -21,6 +37,11 @@ System::System() {
 }
 
 System::~System() {
+    {
+        // devices may outlive the system, and from now on neither resolve trigger groups nor locate themselves
+        std::unique_lock<std::shared_mutex> lock(handle_->mutex);  // waits for calls in progress
+        handle_->system = nullptr;
+    }
     if (arena_system_ != nullptr) {
         // for (auto& device : devices_) {
         //     device->stop();
@@ -34,51 +55,51 @@ System::~System() {
 }
 
 const std::shared_ptr<IDevice> System::init(DeviceInfo device_info) {
-    std::shared_ptr<IDevice> device;
-    try {
-        device = updateDevice_(device_info);
-    } catch (const exception::UnknownModel& e) { throw exception::UnknownModel(); }
-
-    return device;
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    const auto                  found = registry_.find(device_info.serial);
+    if (found == registry_.end()) {
+        return nullptr;
+    }
+    auto& entry = found->second;
+    if (entry.device == nullptr) {
+        entry.device = createDevice_(entry);
+        devices_.push_back(entry.device);
+    }
+    return entry.device;
 }
 
 const std::vector<DeviceInfo> System::scan(const int timeout_ms) {
-    try {
-        arena_system_->UpdateDevices(timeout_ms);
-        last_scanned_devices_info_ = arena_system_->GetDevices();
-    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
-
-    if (last_scanned_devices_info_.empty()) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    const auto                  scanned = refresh_(timeout_ms);
+    if (scanned.empty()) {
         throw exception::DeviceNotFound();
     }
 
-    removeDuplicate_(last_scanned_devices_info_);
-
     std::vector<DeviceInfo> devices_info;
-    for (auto info : last_scanned_devices_info_) {
-        DeviceInfo t_device_info;
-        t_device_info.device_version        = std::string(info.DeviceVersion().c_str());
-        t_device_info.model                 = std::string(info.ModelName().c_str());
-        t_device_info.serial                = std::string(info.SerialNumber().c_str());
-        t_device_info.vendor                = std::string(info.VendorName().c_str());
-        t_device_info.mac                   = std::string(info.MacAddressStr().c_str());
-        t_device_info.ipv4                  = std::string(info.IpAddressStr().c_str());
-        t_device_info.subnet_mask           = std::string(info.SubnetMaskStr().c_str());
-        t_device_info.gateway               = std::string(info.DefaultGatewayStr().c_str());
-        t_device_info.persistent_ip_enabled = info.IsPersistentIpConfigurationEnabled();
-        t_device_info.dhcp_enabled          = info.IsDHCPConfigurationEnabled();
-        t_device_info.lla_enabled           = info.IsLLAConfigurationEnabled();
-        devices_info.emplace_back(t_device_info);
+    devices_info.reserve(scanned.size());
+    for (const auto* entry : scanned) {
+        devices_info.push_back(entry->info);
     }
-
     return devices_info;
 }
 
 void System::fireActionCommand(const int64_t future_time_point) {
-    try {
-        Arena::SetNodeValue(arena_system_->GetTLSystemNodeMap(), "ActionCommandExecuteTime", future_time_point);
-        Arena::ExecuteNode(arena_system_->GetTLSystemNodeMap(), "ActionCommandFireCommand");
-    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+    std::lock_guard<std::mutex> lock(action_mutex_);
+    fireAction_(group_mask_, future_time_point);
+}
+
+void System::fireActionCommand(const std::string& group, const int64_t future_time_point) {
+    std::lock_guard<std::mutex> lock(action_mutex_);
+    fireAction_(groupMaskOf_(group), future_time_point);
+}
+
+void System::fireActionCommand(const std::vector<std::string>& groups, const int64_t future_time_point) {
+    std::lock_guard<std::mutex> lock(action_mutex_);
+    int64_t                     group_mask = 0;
+    for (const auto& group : groups) {
+        group_mask |= groupMaskOf_(group);
+    }
+    fireAction_(group_mask, future_time_point);
 }
 
 void System::setDeviceKey(const int64_t device_key) {
@@ -94,9 +115,12 @@ void System::setGroupKey(const int64_t group_key) {
 }
 
 void System::setGroupMask(const int64_t group_mask) {
+    std::lock_guard<std::mutex> lock(action_mutex_);
     try {
         Arena::SetNodeValue<int64_t>(arena_node_map_, "ActionCommandGroupMask", group_mask);
     } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+    group_mask_         = group_mask;
+    written_group_mask_ = group_mask;
 }
 
 void System::setTargetIp(const int64_t target_ip) {
@@ -113,15 +137,12 @@ void System::configureAddressIpAuto(std::vector<DeviceInfo> devices_info) {
     if (arena_system_ == nullptr) {
         return;  // system is not initialized
     }
+    std::lock_guard<std::mutex>    lock(registry_mutex_);
     std::vector<Arena::DeviceInfo> matched;
-    for (auto arena_device_info : last_scanned_devices_info_) {
-        const auto serial = std::string(arena_device_info.SerialNumber().c_str());
-        for (auto device_info : devices_info) {
-            if (device_info.serial != serial) {
-                continue;
-            }
-            matched.emplace_back(arena_device_info);
-            break;
+    for (const auto& device_info : devices_info) {
+        const auto found = registry_.find(device_info.serial);
+        if (found != registry_.end()) {
+            matched.push_back(found->second.arena_info);
         }
     }
     try {
@@ -131,50 +152,225 @@ void System::configureAddressIpAuto(std::vector<DeviceInfo> devices_info) {
 }
 
 void System::configureAddressIpAuto(DeviceInfo device_info) {
-    if (arena_system_ == nullptr) {
-        return;  // system is not initialized
-    }
-    Arena::DeviceInfo matched;
-    for (auto arena_device_info : last_scanned_devices_info_) {
-        const auto serial = std::string(arena_device_info.SerialNumber().c_str());
-        if (device_info.serial != serial) {
-            continue;  // not matched
+    configureAddressIpAuto(std::vector<DeviceInfo>{device_info});
+}
+
+std::shared_ptr<IDevice> System::find(const std::string& serial_or_mac) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto                        found = registry_.find(serial_or_mac);
+    if (found == registry_.end()) {
+        const auto serial = serials_by_mac_.find(serial_or_mac);
+        if (serial == serials_by_mac_.end()) {
+            return nullptr;
         }
+        found = registry_.find(serial->second);
+    }
+    return (found != registry_.end()) ? found->second.device : nullptr;
+}
+
+int64_t System::triggerGroupMask(const std::string& group) {
+    std::lock_guard<std::mutex> lock(action_mutex_);
+    return groupMaskOf_(group);
+}
+
+std::map<std::string, std::vector<DeviceInfo>> System::groupByInterface(const std::vector<DeviceInfo>& devices_info) {
+    std::map<std::string, std::vector<DeviceInfo>> groups;
+    for (const auto& device_info : devices_info) {
+        groups[device_info.host_ipv4].push_back(device_info);
+    }
+    return groups;
+}
+
+std::map<std::string, std::vector<std::shared_ptr<IDevice>>> System::groupByInterface(
+    const std::vector<std::shared_ptr<IDevice>>& devices) {
+    std::map<std::string, std::vector<std::shared_ptr<IDevice>>> groups;
+    for (const auto& device : devices) {
+        groups[device->info().host_ipv4].push_back(device);
+    }
+    return groups;
+}
+
+void System::forEachInterface(const std::vector<std::shared_ptr<IDevice>>& devices, const InterfaceTask& task) {
+    std::vector<std::future<void>> results;
+    for (const auto& [host_ipv4, group] : groupByInterface(devices)) {
+        results.push_back(std::async(std::launch::async, [&task, host_ipv4 = host_ipv4, group = group]() {
+            task(host_ipv4, group);
+        }));
+    }
+
+    std::exception_ptr error = nullptr;
+    for (auto& result : results) {
         try {
-            std::vector<Arena::DeviceInfo> _info;
-            _info.push_back(arena_device_info);
-            network::autoConfigureIP(arena_system_, _info);
-            arena_system_->UpdateDevices(1000);
-        } catch (const exception::GenericException& e) { throw exception::GenericException(); }
-        break;
-    }
-}
-
-void System::removeDuplicate_(std::vector<Arena::DeviceInfo>& arena_device_info) {
-    std::sort(arena_device_info.begin(), arena_device_info.end(),
-              [](Arena::DeviceInfo& a, Arena::DeviceInfo& b) { return a.SerialNumber() < b.SerialNumber(); });
-    std::vector<Arena::DeviceInfo> filtered;
-    for (auto& info : arena_device_info) {
-        if (filtered.empty() || filtered.back().SerialNumber() != info.SerialNumber()) {
-            filtered.push_back(info);
+            result.get();
+        } catch (...) {
+            error = (error != nullptr) ? error : std::current_exception();
+        }
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+std::vector<LinkBandwidth> System::planBandwidth(const std::vector<std::shared_ptr<IDevice>>& devices,
+                                                 const BandwidthOptions& options, const bool apply) {
+    struct Member {
+        std::shared_ptr<Device> device;
+        std::shared_ptr<Config> config;
+        StreamBandwidth         stream;
+        int64_t                 link_speed = 0;
+    };
+
+    std::map<std::string, std::vector<Member>> groups;  // by host interface
+    for (const auto& device : devices) {
+        const auto lucid_device = std::dynamic_pointer_cast<Device>(device);
+        if (lucid_device == nullptr || lucid_device->getConfig() == nullptr) {
+            throw exception::InvalidConfigValue("bandwidth planning requires opened devices");
+        }
+        Member member;
+        member.device               = lucid_device;
+        member.config               = lucid_device->getConfig();
+        member.stream.serial        = device->info().serial;
+        member.stream.payload_bytes = member.config->getPayloadSize();
+        member.stream.frame_rate    = (options.frame_rate > 0.0) ? options.frame_rate
+                                                                 : member.config->getAcquisitionFrameRate();
+        member.link_speed           = network::linkSpeedOf(*member.config, device->info());
+        groups[device->info().host_ipv4].emplace_back(std::move(member));
+    }
+
+    std::vector<LinkBandwidth> plans;
+    for (auto& [host_ipv4, members] : groups) {
+        LinkBandwidth plan;
+        plan.host_ipv4 = host_ipv4;
+
+        const auto mtu         = network::hostMtuOf(host_ipv4);
+        const auto packet_size = (mtu > 0) ? std::min(options.max_packet_size, mtu) : options.max_packet_size;
+
+        int64_t link_speed = 0;
+        for (const auto& member : members) {
+            link_speed = (link_speed == 0) ? member.link_speed : std::min(link_speed, member.link_speed);
+        }
+        const auto host_link = options.host_link_speeds.find(host_ipv4);
+        if (host_link != options.host_link_speeds.end() && host_link->second > 0) {
+            link_speed = host_link->second;
+        }
+        plan.capacity = static_cast<int64_t>(static_cast<double>(link_speed) * options.headroom);
+
+        for (auto& member : members) {
+            member.stream.packet_size = packet_size;
+            if (apply) {
+                member.stream.packet_size = member.device->applyPacketSize(member.stream.packet_size);
+            }
+            const auto wire_bytes  = network::wireBytesOf(member.stream.payload_bytes, member.stream.packet_size);
+            member.stream.required = static_cast<int64_t>(static_cast<double>(wire_bytes) * member.stream.frame_rate);
+            plan.required += member.stream.required;
+        }
+        plan.fits = (plan.required <= plan.capacity);
+
+        // every stream is paced to its share of the capacity, in proportion to what it needs
+        const auto required = static_cast<double>(plan.required);
+        for (auto& member : members) {
+            const auto packet_bytes = static_cast<double>(network::wirePacketBytesOf(member.stream.packet_size));
+            const auto weight       = (plan.required > 0) ? static_cast<double>(member.stream.required) / required
+                                                          : 1.0;
+            const auto share        = static_cast<double>(plan.capacity) * weight;  // bytes per second
+            const auto line_rate    = static_cast<double>(member.link_speed);
+            const auto delay_ns     = (share > 0.0 && line_rate > 0.0)
+                                        ? packet_bytes * (1.0 / share - 1.0 / line_rate) * 1e9
+                                        : 0.0;
+
+            member.stream.packet_delay = std::max<int64_t>(static_cast<int64_t>(delay_ns), 0);
+            if (apply) {
+                member.device->applyPacketDelay(member.stream.packet_delay);
+            }
+            plan.streams.push_back(member.stream);
+        }
+        plans.emplace_back(std::move(plan));
+    }
+    return plans;
+}
+
+int64_t System::groupMaskOf_(const std::string& group) {
+    const auto found = trigger_groups_.find(group);
+    if (found != trigger_groups_.end()) {
+        return found->second;
+    }
+    const auto bit = trigger_groups_.size() + 1;  // bit 0 is the default mask of devices outside of any group
+    if (bit >= 32) {
+        throw exception::InvalidConfigValue("too many trigger groups: " + group);
+    }
+    const auto group_mask = int64_t{1} << bit;
+    trigger_groups_.emplace(group, group_mask);
+    return group_mask;
+}
+
+void System::fireAction_(const int64_t group_mask, const int64_t future_time_point) {
+    if (!action_group_mask_ || !action_execute_time_ || !action_fire_) {
+        throw exception::GenericException("action commands are not supported by the transport layer");
+    }
+    try {
+        if (group_mask != written_group_mask_) {  // devices filter by mask, so only a change of targets costs a write
+            action_group_mask_->SetValue(group_mask);
+            written_group_mask_ = group_mask;
         }
+        action_execute_time_->SetValue(future_time_point);
+        action_fire_->Execute();
+    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+}
+
+std::optional<Arena::DeviceInfo> System::locate_(const std::string& serial, const int timeout_ms) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    try {
+        refresh_(timeout_ms);
+    } catch (const exception::GenericException& e) { return std::nullopt; }
+
+    const auto found = registry_.find(serial);
+    if (found == registry_.end() || found->second.seen != scans_) {
+        return std::nullopt;  // not found by this scan
     }
-    arena_device_info.clear();
-    arena_device_info = std::vector<Arena::DeviceInfo>(filtered.begin(), filtered.end());
+    return found->second.arena_info;
 }
 
-std::shared_ptr<IDevice> System::updateDevice_(DeviceInfo device_info) {
-    for (auto arena_device_info : last_scanned_devices_info_) {
-        const std::string serial = std::string(arena_device_info.SerialNumber().c_str());
-        if (device_info.serial != serial) {
-            continue;
+std::vector<System::Entry*> System::refresh_(const int timeout_ms) {
+    std::vector<Arena::DeviceInfo> arena_devices_info;
+    try {
+        arena_system_->UpdateDevices(timeout_ms);
+        arena_devices_info = arena_system_->GetDevices();
+    } catch (const GenICam::GenericException& e) { throw exception::GenericException(e.what()); }
+
+    scans_++;
+    std::vector<Entry*> scanned;
+    for (auto& arena_device_info : arena_devices_info) {
+        auto& entry = registry_[std::string(arena_device_info.SerialNumber().c_str())];
+        if (entry.seen == scans_) {
+            continue;  // reported twice, such as through two interfaces
+        }
+        entry.arena_info = std::move(arena_device_info);
+        entry.info       = infoOf_(entry.arena_info);
+        entry.seen       = scans_;
+
+        serials_by_mac_[entry.info.mac] = entry.info.serial;
+        scanned.push_back(&entry);
+    }
+
+    // devices gone for long are forgotten, unless created, since their devices may still be in use and recover
+    for (auto it = registry_.begin(); it != registry_.end();) {
+        const auto& entry = it->second;
+        if (entry.device == nullptr && scans_ - entry.seen >= kRetainedScans) {
+            const auto mac = serials_by_mac_.find(entry.info.mac);
+            if (mac != serials_by_mac_.end() && mac->second == entry.info.serial) {
+                serials_by_mac_.erase(mac);
+            }
+            it = registry_.erase(it);
+        } else {
+            ++it;
         }
-        return createDevice_(arena_device_info);
     }
-    return nullptr;
+    std::sort(scanned.begin(), scanned.end(),
+              [](const Entry* a, const Entry* b) { return a->info.serial < b->info.serial; });
+    return scanned;
 }
 
-std::shared_ptr<IDevice> System::createDevice_(Arena::DeviceInfo arena_device_info) {
+DeviceInfo System::infoOf_(const Arena::DeviceInfo& arena_device_info) {
     DeviceInfo device_info;
     device_info.model          = std::string(arena_device_info.ModelName().c_str());
     device_info.device_version = std::string(arena_device_info.DeviceVersion().c_str());
@@ -184,12 +380,19 @@ std::shared_ptr<IDevice> System::createDevice_(Arena::DeviceInfo arena_device_in
     device_info.ipv4           = std::string(arena_device_info.IpAddressStr().c_str());
     device_info.subnet_mask    = std::string(arena_device_info.SubnetMaskStr().c_str());
     device_info.gateway        = std::string(arena_device_info.DefaultGatewayStr().c_str());
+    device_info.host_ipv4      = network::hostAddressOf(arena_system_, arena_device_info);
 
     device_info.persistent_ip_enabled = arena_device_info.IsPersistentIpConfigurationEnabled();
     device_info.dhcp_enabled          = arena_device_info.IsDHCPConfigurationEnabled();
     device_info.lla_enabled           = arena_device_info.IsLLAConfigurationEnabled();
+    return device_info;
+}
 
-    const auto spec = specOf(utils::parseModel(device_info.model));
+std::shared_ptr<IDevice> System::createDevice_(const Entry& entry) {
+    DeviceInfo device_info = entry.info;
+
+    const auto model = utils::parseModel(device_info.model);
+    const auto spec  = specOf(model);
     if (spec.device_type == DeviceType::UNDEFINED) {  // found unsupported model
         throw exception::UnknownModel();
     }
@@ -199,7 +402,27 @@ std::shared_ptr<IDevice> System::createDevice_(Arena::DeviceInfo arena_device_in
     device_info.max_height  = spec.max_height;
     device_info.rate        = spec.max_rate;
 
-    return std::make_shared<Device>(arena_system_, arena_device_info, device_info);
+    // the device only holds a weak handle of the system, which it may outlive
+    const std::weak_ptr<Handle> weak_handle = handle_;
+    const auto                  resolver    = [weak_handle](const std::string& group) {
+        if (const auto handle = weak_handle.lock()) {
+            std::shared_lock<std::shared_mutex> lock(handle->mutex);
+            if (handle->system != nullptr) {
+                return handle->system->triggerGroupMask(group);
+            }
+        }
+        throw exception::GenericException("trigger group " + group + " is unknown to a closed system");
+    };
+    const auto locator = [weak_handle](const std::string& serial, const int timeout_ms) {
+        if (const auto handle = weak_handle.lock()) {
+            std::shared_lock<std::shared_mutex> lock(handle->mutex);
+            if (handle->system != nullptr) {
+                return handle->system->locate_(serial, timeout_ms);
+            }
+        }
+        return std::optional<Arena::DeviceInfo>();  // nowhere to search once the system is closed
+    };
+    return makeDevice(model, arena_system_, entry.arena_info, device_info, resolver, locator);
 }
 
 }  // namespace lucid
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <numeric>
+
+#include "camera/exception.h"
+#include "camera/lucid/device.hpp"
+#include "camera/lucid/network.hpp"
+#include "camera/lucid/trigger.hpp"
+
+namespace camera {
+namespace lucid {
+
+namespace {
+std::shared_ptr<Config> configOf(const std::shared_ptr<IDevice>& device) {
+    const auto lucid_device = std::dynamic_pointer_cast<Device>(device);
+    return (lucid_device != nullptr) ? lucid_device->getConfig() : nullptr;
+}
+}  // namespace
+
+TriggerPlanner::TriggerPlanner(const std::vector<std::shared_ptr<IDevice>>& devices, const Options& options)
+    : devices_(devices)
+    , options_(options) {}
+
+std::vector<TriggerPlanner::Burst> TriggerPlanner::plan() {
+    std::vector<Burst> bursts;
+    for (const auto& device : devices_) {
+        const auto config = configOf(device);
+        if (config == nullptr) {
+            throw exception::InvalidConfigValue("trigger planning requires opened devices");
+        }
+
+        Burst burst;
+        burst.serial        = device->info().serial;
+        burst.host_ipv4     = device->info().host_ipv4;
+        burst.payload_bytes = config->getPayloadSize();
+        burst.packet_size   = config->getGevSCPSPacketSize();
+        burst.packet_delay  = config->getGevSCPD();
+        burst.link_speed    = network::linkSpeedOf(*config, device->info());
+        burst.exposure_ns   = static_cast<int64_t>(config->getExposureTime() * 1000.0);
+
+        const auto host_link = options_.host_link_speeds.find(burst.host_ipv4);
+        if (host_link != options_.host_link_speeds.end() && host_link->second > 0) {
+            const auto host_speed = host_link->second;
+            burst.link_speed      = (burst.link_speed > 0) ? std::min(burst.link_speed, host_speed) : host_speed;
+        }
+        if (burst.link_speed <= 0) {
+            throw exception::InvalidConfigValue("link speed is unknown for " + burst.serial);
+        }
+        // a paced stream waits the packet delay after every packet, see `System::planBandwidth()`
+        const auto wire_bytes = network::wireBytesOf(burst.payload_bytes, burst.packet_size);
+        const auto packets    = network::packetsOf(burst.payload_bytes, burst.packet_size);
+        const auto send_ns    = static_cast<double>(wire_bytes) * 1e9 / static_cast<double>(burst.link_speed);
+        burst.duration_ns     = static_cast<int64_t>(send_ns) + packets * std::max<int64_t>(burst.packet_delay, 0);
+        bursts.emplace_back(std::move(burst));
+    }
+
+    // devices with shorter exposures are read out first, as they can start sending earliest
+    std::vector<std::size_t> order(bursts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b) {
+        return bursts[a].exposure_ns < bursts[b].exposure_ns;
+    });
+
+    std::map<std::string, int64_t> link_free_ns;  // per host interface, when its link is available again
+    for (const auto i : order) {
+        auto&      burst   = bursts[i];
+        const auto free_ns = link_free_ns[burst.host_ipv4];
+
+        burst.delay_ns = std::max<int64_t>(free_ns - burst.exposure_ns, 0);
+        burst.end_ns   = burst.delay_ns + burst.exposure_ns + burst.duration_ns;
+
+        const auto guard_ns           = static_cast<int64_t>(options_.guard_ratio * burst.duration_ns);
+        link_free_ns[burst.host_ipv4] = burst.end_ns + guard_ns;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bursts_ = bursts;
+    return bursts;
+}
+
+void TriggerPlanner::apply() {
+    auto bursts = report();
+    if (bursts.empty()) {
+        bursts = plan();
+    }
+    for (std::size_t i = 0; i < devices_.size() && i < bursts.size(); i++) {
+        const auto lucid_device = std::dynamic_pointer_cast<Device>(devices_[i]);
+        if (lucid_device == nullptr) {
+            throw exception::InvalidConfigValue("trigger planning requires opened devices");
+        }
+        // kept in the parameters of the device, which a recovery applies again
+        lucid_device->applyTriggerDelay(static_cast<double>(bursts[i].delay_ns) / 1000.0);  // microseconds
+    }
+}
+
+int64_t TriggerPlanner::observe(const std::size_t device, const IImage& image, const uint64_t received_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto&                       burst = bursts_.at(device);
+
+    // stamps mark the start of the exposure, which follows the trigger by the delay
+    const auto trigger_ns = static_cast<int64_t>(image.header.stamp) - burst.delay_ns;
+    const auto elapsed_ns = static_cast<int64_t>(received_ns) - trigger_ns;
+
+    burst.samples++;
+    burst.measured_end_ns += (static_cast<double>(elapsed_ns) - burst.measured_end_ns) / burst.samples;
+    burst.measured_max_ns = std::max(burst.measured_max_ns, elapsed_ns);
+    return elapsed_ns;
+}
+
+std::vector<TriggerPlanner::Burst> TriggerPlanner::report() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bursts_;
+}
+
+int64_t TriggerPlanner::latency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t                     latency = 0;
+    for (const auto& burst : bursts_) {
+        latency = std::max(latency, burst.end_ns);
+    }
+    return latency;
+}
+
+}  // namespace lucid
+}  // namespace camera
@@ -0,0 +1,100 @@
+#include <algorithm>
+
+#include "camera/pool.h"
+
+namespace camera {
+
+namespace {
+constexpr std::size_t kClassesPerDoubling = 8;     // bounds the memory wasted by rounding to 1/8 of a buffer
+constexpr std::size_t kMinClassBytes      = 4096;  // smaller buffers are rounded to a page
+
+/**
+ * @brief Rounds a size up to its size class, so that frames of slightly varying size, such as incomplete or chunked
+ * frames, share their buffers.
+ */
+std::size_t sizeClassOf(const std::size_t size) {
+    if (size <= kMinClassBytes) {
+        return kMinClassBytes;
+    }
+    std::size_t doubling = kMinClassBytes;
+    while (doubling * 2 < size) {
+        doubling *= 2;
+    }
+    const auto step = doubling / kClassesPerDoubling;
+    return (size + step - 1) / step * step;
+}
+}  // namespace
+
+void BufferDeleter::operator()(uint8_t* ptr) const {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (release) {
+        release(ptr);
+    } else if (pool != nullptr) {
+        pool->recycle(ptr, capacity);
+    } else {
+        delete[] ptr;
+    }
+}
+
+BufferPool::BufferPool(const std::size_t max_cached_bytes, std::vector<std::size_t> exact_sizes)
+    : exact_sizes_(std::move(exact_sizes))
+    , max_cached_bytes_(max_cached_bytes) {
+    std::sort(exact_sizes_.begin(), exact_sizes_.end());
+}
+
+BufferPool::~BufferPool() {
+    clear();
+}
+
+Buffer BufferPool::acquire(const std::size_t size) {
+    const auto capacity = sizeClassOf_(size);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto                        found = idle_.find(capacity);
+        if (found != idle_.end() && !found->second.empty()) {
+            uint8_t* ptr = found->second.back();
+            found->second.pop_back();
+            cached_bytes_ -= capacity;
+            return Buffer(ptr, BufferDeleter(shared_from_this(), capacity));
+        }
+    }
+    return Buffer(new uint8_t[capacity], BufferDeleter(shared_from_this(), capacity));
+}
+
+std::size_t BufferPool::sizeClassOf_(const std::size_t size) const {
+    const auto rounded = sizeClassOf(size);
+    const auto exact   = std::lower_bound(exact_sizes_.begin(), exact_sizes_.end(), size);
+    return (exact != exact_sizes_.end() && *exact < rounded) ? *exact : rounded;
+}
+
+void BufferPool::recycle(uint8_t* ptr, const std::size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cached_bytes_ + size <= max_cached_bytes_) {
+            idle_[size].push_back(ptr);
+            cached_bytes_ += size;
+            return;
+        }
+    }
+    delete[] ptr;
+}
+
+void BufferPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [size, buffers] : idle_) {
+        for (auto* ptr : buffers) {
+            delete[] ptr;
+        }
+    }
+    idle_.clear();
+    cached_bytes_ = 0;
+}
+
+std::size_t BufferPool::cachedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_bytes_;
+}
+
+}  // namespace camera
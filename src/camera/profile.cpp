@@ -0,0 +1,198 @@
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+#include "camera/exception.h"
+#include "camera/profile.h"
+
+namespace camera {
+namespace profile {
+
+namespace {
+/**
+ * @brief Passes every parameter to the visitor together with its name, in a fixed order.
+ */
+template<typename Param, typename Visitor>
+void visit(Param& param, Visitor&& visitor) {
+    visitor("action_device_key", param.action_device_key);
+    visitor("action_group_key", param.action_group_key);
+    visitor("action_group_mask", param.action_group_mask);
+    visitor("action_selector", param.action_selector);
+    visitor("action_unconditional_mode", param.action_unconditional_mode);
+    visitor("acquisition_frame_rate", param.acquisition_frame_rate);
+    visitor("acquisition_mode", param.acquisition_mode);
+    visitor("acquisition_start_mode", param.acquisition_start_mode);
+    visitor("binning_horizontal", param.binning_horizontal);
+    visitor("binning_horizontal_mode", param.binning_horizontal_mode);
+    visitor("binning_selector", param.binning_selector);
+    visitor("binning_vertical", param.binning_vertical);
+    visitor("binning_vertical_mode", param.binning_vertical_mode);
+    visitor("chunk_enable", param.chunk_enable);
+    visitor("chunk_mode_active", param.chunk_mode_active);
+    visitor("conversion_gain", param.conversion_gain);
+    visitor("exposure_auto", param.exposure_auto);
+    visitor("exposure_auto_limit_auto", param.exposure_auto_limit_auto);
+    visitor("exposure_auto_lower_limit", param.exposure_auto_lower_limit);
+    visitor("exposure_auto_upper_limit", param.exposure_auto_upper_limit);
+    visitor("exposure_time", param.exposure_time);
+    visitor("gain_auto", param.gain_auto);
+    visitor("gev_current_ip_configuration_dhcp", param.gev_current_ip_configuration_dhcp);
+    visitor("persistent_ip_enable", param.persistent_ip_enable);
+    visitor("gev_scda", param.gev_scda);
+    visitor("height", param.height);
+    visitor("pixel_format", param.pixel_format);
+    visitor("profile_user_set", param.profile_user_set);
+    visitor("profile_directory", param.profile_directory);
+    visitor("ptp_enable", param.ptp_enable);
+    visitor("ptp_slave_only", param.ptp_slave_only);
+    visitor("reverse_x", param.reverse_x);
+    visitor("reverse_y", param.reverse_y);
+    visitor("stream_auto_negotiate_packet_size", param.stream_auto_negotiate_packet_size);
+    visitor("stream_buffer_handling_mode", param.stream_buffer_handling_mode);
+    visitor("stream_multicast_enable", param.stream_multicast_enable);
+    visitor("stream_multicast_receiver_only", param.stream_multicast_receiver_only);
+    visitor("auto_reconnect", param.auto_reconnect);
+    visitor("stream_packet_resend_enable", param.stream_packet_resend_enable);
+    visitor("stream_packet_size", param.stream_packet_size);
+    visitor("stream_packet_delay", param.stream_packet_delay);
+    visitor("target_brightness", param.target_brightness);
+    visitor("transfer_control_mode", param.transfer_control_mode);
+    visitor("transfer_operation_mode", param.transfer_operation_mode);
+    visitor("trigger_activation", param.trigger_activation);
+    visitor("trigger_delay", param.trigger_delay);
+    visitor("trigger_group", param.trigger_group);
+    visitor("trigger_latency", param.trigger_latency);
+    visitor("trigger_mode", param.trigger_mode);
+    visitor("trigger_overlap", param.trigger_overlap);
+    visitor("trigger_selector", param.trigger_selector);
+    visitor("trigger_source", param.trigger_source);
+    visitor("width", param.width);
+}
+
+void write(std::ostream& os, const int64_t value) {
+    os << value;
+}
+
+void write(std::ostream& os, const double value) {
+    os << std::setprecision(17) << value;  // enough digits to read back the same value
+}
+
+void write(std::ostream& os, const bool value) {
+    os << (value ? "true" : "false");
+}
+
+void write(std::ostream& os, const std::string& value) {
+    os << value;
+}
+
+template<typename E, typename = std::enable_if_t<std::is_enum_v<E>>>
+void write(std::ostream& os, const E value) {
+    os << nameOf(value);
+}
+
+void write(std::ostream& os, const std::vector<std::string>& values) {
+    for (std::size_t i = 0; i < values.size(); i++) {
+        os << (i > 0 ? "," : "") << values[i];
+    }
+}
+
+bool read(const std::string& text, int64_t& value) {
+    std::istringstream is(text);
+    return static_cast<bool>(is >> value) && is.eof();
+}
+
+bool read(const std::string& text, double& value) {
+    std::istringstream is(text);
+    return static_cast<bool>(is >> value) && is.eof();
+}
+
+bool read(const std::string& text, bool& value) {
+    value = (text == "true");
+    return value || text == "false";
+}
+
+bool read(const std::string& text, std::string& value) {
+    value = text;
+    return true;
+}
+
+template<typename E, typename = std::enable_if_t<std::is_enum_v<E>>>
+bool read(const std::string& text, E& value) {
+    return valueOf(text, value);
+}
+
+bool read(const std::string& text, std::vector<std::string>& values) {
+    values.clear();
+    std::istringstream is(text);
+    for (std::string value; std::getline(is, value, ',');) {
+        values.push_back(value);
+    }
+    return true;
+}
+}  // namespace
+
+std::string serialize(const DeviceParameters& param) {
+    std::ostringstream os;
+    visit(param, [&](const char* name, const auto& value) {
+        os << name << '=';
+        write(os, value);
+        os << '\n';
+    });
+    return os.str();
+}
+
+DeviceParameters parse(const std::string& text) {
+    DeviceParameters   param;
+    std::istringstream is(text);
+    for (std::string line; std::getline(is, line);) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const auto separator = line.find('=');
+        const auto name      = line.substr(0, separator);
+        const auto value     = (separator != std::string::npos) ? line.substr(separator + 1) : "";
+
+        bool is_known = false;
+        bool is_valid = false;
+        visit(param, [&](const char* field, auto& field_value) {
+            if (!is_known && name == field) {
+                is_known = true;
+                is_valid = read(value, field_value);
+            }
+        });
+        if (!is_known || !is_valid) {
+            throw exception::InvalidConfigValue("invalid profile line: " + line);
+        }
+    }
+    return param;
+}
+
+uint64_t hashOf(const DeviceParameters& param) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto c : serialize(param)) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+void save(const std::filesystem::path& path, const DeviceParameters& param) {
+    std::ofstream file(path, std::ios::trunc);
+    file << "# " << std::hex << std::setw(16) << std::setfill('0') << hashOf(param) << '\n' << serialize(param);
+    if (!file) {
+        throw exception::GenericException("failed to write profile " + path.string());
+    }
+}
+
+DeviceParameters load(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw exception::GenericException("failed to read profile " + path.string());
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return parse(text.str());
+}
+
+}  // namespace profile
+}  // namespace camera
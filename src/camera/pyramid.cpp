@@ -0,0 +1,378 @@
+#include <algorithm>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+#include "camera/exception.h"
+#include "camera/pyramid.h"
+
+namespace camera {
+
+namespace {
+constexpr std::size_t kSlack    = 8;  // values past the end of a row of sums, which the vector kernels may write
+constexpr int         kMaxShift = 8;  // sums of 8-bit values weighted by up to 2^8 fit 16 bits
+
+/**
+ * @brief Writes the sum of two rows of 8-bit values, widened to 16 bits.
+ */
+void addRows(const uint8_t* top, const uint8_t* bottom, uint16_t* dst, const std::size_t size) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8),
+                         _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t a = vld1q_u8(top + i);
+        const uint8x16_t b = vld1q_u8(bottom + i);
+        vst1q_u16(dst + i, vaddl_u8(vget_low_u8(a), vget_low_u8(b)));
+        vst1q_u16(dst + i + 8, vaddl_u8(vget_high_u8(a), vget_high_u8(b)));
+    }
+#endif
+    for (; i < size; i++) {
+        dst[i] = static_cast<uint16_t>(top[i] + bottom[i]);
+    }
+}
+
+/**
+ * @brief Writes the sum of two rows of sums, or their rounded mean if `kExact` is false.
+ */
+template<bool kExact>
+void addRows(const uint16_t* top, const uint16_t* bottom, uint16_t* dst, const std::size_t size) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 8 <= size; i += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), kExact ? _mm_add_epi16(a, b) : _mm_avg_epu16(a, b));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 8 <= size; i += 8) {
+        const uint16x8_t a = vld1q_u16(top + i);
+        const uint16x8_t b = vld1q_u16(bottom + i);
+        vst1q_u16(dst + i, kExact ? vaddq_u16(a, b) : vrhaddq_u16(a, b));
+    }
+#endif
+    for (; i < size; i++) {
+        dst[i] = static_cast<uint16_t>(kExact ? top[i] + bottom[i] : (top[i] + bottom[i] + 1) >> 1);
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Adds the two 16-bit values of every 32-bit lane, or takes their rounded mean if `kExact` is false.
+ */
+template<bool kExact>
+__m128i addPairs(const __m128i v) {
+    const __m128i sum = _mm_add_epi32(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(v, 16));
+    return kExact ? sum : _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1)), 1);
+}
+
+/**
+ * @brief Packs 32-bit lanes holding 16-bit values into 16-bit lanes. SSE2 only packs with signed saturation, so the
+ *      values are moved into the signed range and back.
+ */
+__m128i packLanes(const __m128i a, const __m128i b) {
+    const __m128i bias = _mm_set1_epi32(0x8000);
+    return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias)),
+                         _mm_set1_epi16(static_cast<int16_t>(0x8000)));
+}
+
+/**
+ * @brief Stores the two pixels of three values each held in the first three lanes of either half of a register.
+ *      The fourth lane of each half lands on the next pixel, which is written afterwards, or on the slack of the row.
+ */
+void storePixels(uint16_t* dst, const __m128i pixels) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), pixels);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 3), _mm_srli_si128(pixels, 8));
+}
+#endif
+
+/**
+ * @brief Writes the sum of every pair of adjacent values of a single-channel row of sums, or their rounded mean if
+ *      `kExact` is false.
+ * @param cols [in] Number of output values, reading `2 * cols` input values.
+ */
+template<bool kExact>
+void halveMono(const uint16_t* src, uint16_t* dst, const std::size_t cols) {
+    std::size_t x = 0;
+#if defined(__SSE2__)
+    for (; x + 8 <= cols; x += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * x));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * x + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), packLanes(addPairs<kExact>(a), addPairs<kExact>(b)));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= cols; x += 8) {
+        const uint16x8x2_t pairs = vld2q_u16(src + 2 * x);
+        vst1q_u16(dst + x, kExact ? vaddq_u16(pairs.val[0], pairs.val[1]) : vrhaddq_u16(pairs.val[0], pairs.val[1]));
+    }
+#endif
+    for (; x < cols; x++) {
+        const auto sum = src[2 * x] + src[2 * x + 1];
+        dst[x]         = static_cast<uint16_t>(kExact ? sum : (sum + 1) >> 1);
+    }
+}
+
+/**
+ * @brief Writes the sum of every pair of adjacent pixels of a three-channel row of sums, or their rounded mean if
+ *      `kExact` is false.
+ * @param cols [in] Number of output pixels, reading `2 * cols` input pixels.
+ */
+template<bool kExact>
+void halveTriple(const uint16_t* src, uint16_t* dst, const std::size_t cols) {
+    std::size_t x = 0;
+#if defined(__SSE2__)
+    for (; x + 2 <= cols; x += 2) {
+        const uint16_t* in = src + 6 * x;
+        const __m128i   a  = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)),
+                                                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 6)));
+        const __m128i   b  = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 3)),
+                                                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 9)));
+        storePixels(dst + 3 * x, kExact ? _mm_add_epi16(a, b) : _mm_avg_epu16(a, b));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= cols; x += 8) {
+        const uint16x8x3_t a = vld3q_u16(src + 6 * x);
+        const uint16x8x3_t b = vld3q_u16(src + 6 * x + 24);
+        uint16x8x3_t       out;
+        for (int c = 0; c < 3; c++) {
+            const uint16x8x2_t pairs = vuzpq_u16(a.val[c], b.val[c]);  // even and odd pixels
+            out.val[c] = kExact ? vaddq_u16(pairs.val[0], pairs.val[1]) : vrhaddq_u16(pairs.val[0], pairs.val[1]);
+        }
+        vst3q_u16(dst + 3 * x, out);
+    }
+#endif
+    for (; x < cols; x++) {
+        for (std::size_t c = 0; c < 3; c++) {
+            const auto sum = src[6 * x + c] + src[6 * x + 3 + c];
+            dst[3 * x + c] = static_cast<uint16_t>(kExact ? sum : (sum + 1) >> 1);
+        }
+    }
+}
+
+/**
+ * @brief Writes the sum of every 2x2 quad of two single-channel rows.
+ * @param cols [in] Number of output values, reading `2 * cols` input values per row.
+ */
+void quadMono(const uint8_t* top, const uint8_t* bottom, uint16_t* dst, const std::size_t cols) {
+    std::size_t x = 0;
+#if defined(__SSE2__)
+    const __m128i low = _mm_set1_epi16(0x00FF);
+    for (; x + 8 <= cols; x += 8) {
+        const __m128i t    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * x));
+        const __m128i b    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * x));
+        const __m128i even = _mm_add_epi16(_mm_and_si128(t, low), _mm_and_si128(b, low));
+        const __m128i odd  = _mm_add_epi16(_mm_srli_epi16(t, 8), _mm_srli_epi16(b, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_add_epi16(even, odd));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= cols; x += 8) {
+        vst1q_u16(dst + x, vpadalq_u8(vpaddlq_u8(vld1q_u8(top + 2 * x)), vld1q_u8(bottom + 2 * x)));
+    }
+#endif
+    for (; x < cols; x++) {
+        dst[x] = static_cast<uint16_t>(top[2 * x] + top[2 * x + 1] + bottom[2 * x] + bottom[2 * x + 1]);
+    }
+}
+
+/**
+ * @brief Turns every 2x2 quad of two BayerRG8 rows into the sums of one RGB pixel, weighting each color by 2: twice
+ *      the red, the sum of both greens and twice the blue.
+ * @param cols [in] Number of output pixels, reading `2 * cols` input pixels per row.
+ */
+void quadRG8(const uint8_t* top, const uint8_t* bottom, uint16_t* dst, const std::size_t cols) {
+    std::size_t x = 0;
+#if defined(__SSE2__)
+    const __m128i low  = _mm_set1_epi16(0x00FF);
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 8 <= cols; x += 8) {
+        const __m128i t     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * x));
+        const __m128i b     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * x));
+        const __m128i red   = _mm_slli_epi16(_mm_and_si128(t, low), 1);
+        const __m128i green = _mm_add_epi16(_mm_srli_epi16(t, 8), _mm_and_si128(b, low));
+        const __m128i blue  = _mm_slli_epi16(_mm_srli_epi16(b, 8), 1);
+
+        // red and green of each pixel next to its blue and a zero, two pixels per register
+        const __m128i rg_low  = _mm_unpacklo_epi16(red, green);
+        const __m128i rg_high = _mm_unpackhi_epi16(red, green);
+        const __m128i b_low   = _mm_unpacklo_epi16(blue, zero);
+        const __m128i b_high  = _mm_unpackhi_epi16(blue, zero);
+        storePixels(dst + 3 * x, _mm_unpacklo_epi32(rg_low, b_low));
+        storePixels(dst + 3 * x + 6, _mm_unpackhi_epi32(rg_low, b_low));
+        storePixels(dst + 3 * x + 12, _mm_unpacklo_epi32(rg_high, b_high));
+        storePixels(dst + 3 * x + 18, _mm_unpackhi_epi32(rg_high, b_high));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 16 <= cols; x += 16) {
+        const uint8x16x2_t t = vld2q_u8(top + 2 * x);  // red and green
+        const uint8x16x2_t b = vld2q_u8(bottom + 2 * x);  // green and blue
+        uint16x8x3_t       out;
+        out.val[0] = vshll_n_u8(vget_low_u8(t.val[0]), 1);
+        out.val[1] = vaddl_u8(vget_low_u8(t.val[1]), vget_low_u8(b.val[0]));
+        out.val[2] = vshll_n_u8(vget_low_u8(b.val[1]), 1);
+        vst3q_u16(dst + 3 * x, out);
+        out.val[0] = vshll_n_u8(vget_high_u8(t.val[0]), 1);
+        out.val[1] = vaddl_u8(vget_high_u8(t.val[1]), vget_high_u8(b.val[0]));
+        out.val[2] = vshll_n_u8(vget_high_u8(b.val[1]), 1);
+        vst3q_u16(dst + 3 * x + 24, out);
+    }
+#endif
+    for (; x < cols; x++) {
+        uint16_t* out = dst + 3 * x;
+        out[0]        = static_cast<uint16_t>(top[2 * x] << 1);
+        out[1]        = static_cast<uint16_t>(top[2 * x + 1] + bottom[2 * x]);
+        out[2]        = static_cast<uint16_t>(bottom[2 * x + 1] << 1);
+    }
+}
+
+/**
+ * @brief Writes the rounded 8-bit pixels of a row of sums weighted by `2^shift`.
+ */
+void narrow(const uint16_t* src, uint8_t* dst, const std::size_t size, const int shift) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i half  = _mm_set1_epi16(static_cast<int16_t>(1 << (shift - 1)));
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packus_epi16(_mm_srl_epi16(_mm_add_epi16(a, half), count),
+                                          _mm_srl_epi16(_mm_add_epi16(b, half), count)));
+    }
+#elif defined(__ARM_NEON)
+    const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(-shift));  // a negative left shift rounds to the right
+    for (; i + 16 <= size; i += 16) {
+        const uint16x8_t a = vrshlq_u16(vld1q_u16(src + i), count);
+        const uint16x8_t b = vrshlq_u16(vld1q_u16(src + i + 8), count);
+        vst1q_u8(dst + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+#endif
+    for (; i < size; i++) {
+        dst[i] = static_cast<uint8_t>((src[i] + (1 << (shift - 1))) >> shift);
+    }
+}
+
+/**
+ * @brief Adds two rows of sums of a level into the sums of a row of the next, coarser level.
+ * @param wide [out] Scratch of the sums of the rows, before adding their horizontal pairs.
+ * @param cols [in] Number of pixels of the coarser level.
+ */
+template<bool kExact>
+void reduce(const uint16_t* top, const uint16_t* bottom, uint16_t* wide, uint16_t* dst, const std::size_t cols,
+            const std::size_t channels) {
+    addRows<kExact>(top, bottom, wide, 2 * cols * channels);
+    if (channels == 1) {
+        halveMono<kExact>(wide, dst, cols);
+    } else {
+        halveTriple<kExact>(wide, dst, cols);
+    }
+}
+}  // namespace
+
+Pyramid::Pyramid(const std::size_t num_levels, std::shared_ptr<BufferPool> pool)
+    : num_levels_(num_levels)
+    , pool_(pool != nullptr ? std::move(pool) : std::make_shared<BufferPool>()) {}
+
+void Pyramid::process(IImage& image) {
+    std::size_t channels = 0;
+    PixelFormat format   = image.format;
+    switch (image.format) {
+    case PixelFormat::MONO8:
+        channels = 1;
+        break;
+    case PixelFormat::RGB8:
+    case PixelFormat::BGR8:
+        channels = 3;
+        break;
+    case PixelFormat::BAYER_RG8:
+        channels = 3;
+        format   = PixelFormat::RGB8;
+        break;
+    default:
+        throw exception::InvalidConfigValue("unsupported pixel format for pyramid");
+    }
+    const bool is_bayer = (image.format == PixelFormat::BAYER_RG8);
+
+    image.levels.clear();
+    std::size_t rows = image.rows / 2;
+    std::size_t cols = image.cols / 2;
+    for (std::size_t i = 0; i < num_levels_ && rows > 0 && cols > 0; i++, rows /= 2, cols /= 2) {
+        auto level      = std::make_shared<IImage>();
+        level->complete = image.complete;
+        level->header   = image.header;
+        level->rows     = rows;
+        level->cols     = cols;
+        level->step     = cols * channels;
+        level->depth    = 8 * channels;
+        level->format   = format;
+        level->data     = pool_->acquire(level->step * rows);
+        image.levels.push_back(std::move(level));
+    }
+    if (image.levels.empty()) {
+        return;
+    }
+    const std::size_t num_levels = image.levels.size();
+    wide_.resize(2 * image.levels.front()->step + kSlack);
+    sums_.resize(2 * num_levels);
+    for (std::size_t i = 0; i < num_levels; i++) {
+        sums_[2 * i].resize(image.levels[i]->step + kSlack);
+        sums_[2 * i + 1].resize(image.levels[i]->step + kSlack);
+    }
+
+    // each level holds the sums of the pixels it covers, weighted by 2^shift, and is rounded from them only once
+    const int first_shift = is_bayer ? 1 : 2;
+
+    // every row of sums of a level completes a row pair of the next, coarser level whenever its index is odd, so
+    // that the coarser row is computed right away from the two rows just written.
+    for (std::size_t y = 0; y < image.levels.front()->rows; y++) {
+        const uint8_t* top    = image.data.get() + 2 * y * image.step;
+        const uint8_t* bottom = top + image.step;
+
+        IImage&   first = *image.levels.front();
+        uint16_t* sums  = sums_[y % 2].data();
+        if (is_bayer) {
+            quadRG8(top, bottom, sums, first.cols);
+        } else if (channels == 1) {
+            quadMono(top, bottom, sums, first.cols);
+        } else {
+            addRows(top, bottom, wide_.data(), 2 * first.step);
+            halveTriple<true>(wide_.data(), sums, first.cols);
+        }
+        narrow(sums, first.data.get() + y * first.step, first.step, first_shift);
+
+        std::size_t row   = y;
+        int         shift = first_shift;
+        for (std::size_t i = 1; i < num_levels && row % 2 == 1; i++) {
+            IImage& coarse = *image.levels[i];
+            row            = row / 2;
+            if (row >= coarse.rows) {
+                break;
+            }
+            const uint16_t* finer_top    = sums_[2 * (i - 1)].data();
+            const uint16_t* finer_bottom = sums_[2 * (i - 1) + 1].data();
+            uint16_t*       coarse_sums  = sums_[2 * i + row % 2].data();
+
+            // once the sums would overflow 16 bits, they are averaged instead, keeping 8 bits below the pixel value
+            if (shift + 2 <= kMaxShift) {
+                reduce<true>(finer_top, finer_bottom, wide_.data(), coarse_sums, coarse.cols, channels);
+                shift += 2;
+            } else {
+                reduce<false>(finer_top, finer_bottom, wide_.data(), coarse_sums, coarse.cols, channels);
+            }
+            narrow(coarse_sums, coarse.data.get() + row * coarse.step, coarse.step, shift);
+        }
+    }
+}
+
+}  // namespace camera
@@ -0,0 +1,437 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "camera/exception.h"
+#include "camera/server.h"
+
+namespace camera {
+
+namespace {
+sockaddr_un addressOf(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw exception::InvalidConfigValue("socket path is too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+exception::GenericException systemError(const std::string& what) {
+    return exception::GenericException(what + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief Sends the message with the file descriptor attached, without blocking.
+ * @return 0 on success, otherwise errno.
+ */
+int sendWithFd(const int socket_fd, const wire::FrameMessage& message, const int fd) {
+    iovec iov{};
+    iov.iov_base = const_cast<wire::FrameMessage*>(&message);
+    iov.iov_len  = sizeof(message);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    msghdr msg{};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cmsg    = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    return (sendmsg(socket_fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) ? errno : 0;
+}
+}  // namespace
+
+FrameServer::FrameServer(const std::string& path, const std::size_t max_subscribers, const std::size_t num_slots)
+    : path_(path)
+    , max_subscribers_(max_subscribers)
+    , slots_(std::max<std::size_t>(num_slots, 1))
+    , stop_requested_(false) {
+    const auto addr = addressOf(path_);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listen_fd_ < 0) {
+        throw systemError("socket");
+    }
+    unlink(path_.c_str());
+    if (bind(listen_fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+        || listen(listen_fd_, static_cast<int>(max_subscribers_)) != 0) {
+        const auto error = systemError("bind " + path_);
+        close(listen_fd_);
+        throw error;
+    }
+
+    wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeup_fd_ < 0) {
+        const auto error = systemError("eventfd");
+        close(listen_fd_);
+        throw error;
+    }
+
+    worker_ = std::thread(&FrameServer::run_, this);
+}
+
+FrameServer::~FrameServer() {
+    stop_requested_.store(true);
+    eventfd_write(wakeup_fd_, 1);
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    for (auto& subscriber : subscribers_) {
+        close(subscriber.id);
+    }
+    for (auto& slot : slots_) {
+        if (slot.data != nullptr) {
+            munmap(slot.data, slot.capacity);
+        }
+        if (slot.fd >= 0) {
+            close(slot.read_fd);
+            close(slot.fd);
+        }
+    }
+    close(wakeup_fd_);
+    close(listen_fd_);
+    unlink(path_.c_str());
+}
+
+std::size_t FrameServer::publish(const IImage& image) {
+    const std::size_t size = image.step * image.rows;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const bool                   is_wanted = std::any_of(subscribers_.begin(), subscribers_.end(),
+                                                         [](const Subscriber& s) { return s.credits > 0; });
+    // the slot taken is neither held by a subscriber nor written by another publisher
+    std::size_t index = slots_.size();
+    for (std::size_t i = 0; is_wanted && i < slots_.size() && index == slots_.size(); i++) {
+        const auto candidate = (next_slot_ + i) % slots_.size();
+        if (!slots_[candidate].writing && slots_[candidate].holders.empty()) {
+            index = candidate;
+        }
+    }
+    if (index == slots_.size()) {
+        for (auto& subscriber : subscribers_) {
+            subscriber.dropped++;
+        }
+        return 0;
+    }
+    Slot& slot   = slots_[index];
+    slot.writing = true;
+    next_slot_   = index + 1;
+    lock.unlock();
+
+    try {
+        reserve_(slot, size);
+        if (size > 0) {
+            std::memcpy(slot.data, image.data.get(), size);
+        }
+    } catch (...) {
+        lock.lock();
+        slot.writing = false;
+        throw;
+    }
+
+    wire::FrameMessage message{};
+    message.magic    = wire::kFrameMagic;
+    message.version  = wire::kVersion;
+    message.stamp    = image.header.stamp;
+    message.seq      = image.header.seq;
+    message.rows     = image.rows;
+    message.cols     = image.cols;
+    message.step     = image.step;
+    message.depth    = image.depth;
+    message.size     = size;
+    message.complete = image.complete ? 1U : 0U;
+    message.slot     = static_cast<uint32_t>(index);
+
+    lock.lock();
+    slot.writing          = false;
+    std::size_t delivered = 0;
+    for (auto& subscriber : subscribers_) {
+        if (subscriber.credits <= 0) {
+            subscriber.dropped++;
+            continue;
+        }
+        const int error = sendWithFd(subscriber.id, message, slot.read_fd);
+        if (error == 0) {
+            subscriber.credits--;
+            subscriber.sent++;
+            slot.holders.push_back(subscriber.id);
+            delivered++;
+        } else {
+            subscriber.dropped++;  // socket buffer is full or the peer is gone, which run_() cleans up
+        }
+    }
+    return delivered;
+}
+
+std::vector<FrameServer::Subscriber> FrameServer::subscribers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_;
+}
+
+void FrameServer::run_() {
+    std::vector<pollfd> fds;
+    while (!stop_requested_.load()) {
+        fds.clear();
+        fds.push_back(pollfd{wakeup_fd_, POLLIN, 0});
+        fds.push_back(pollfd{listen_fd_, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& subscriber : subscribers_) {
+                fds.push_back(pollfd{subscriber.id, POLLIN, 0});
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            accept_();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 2; i < fds.size(); i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            auto found = std::find_if(subscribers_.begin(), subscribers_.end(),
+                                      [&](const Subscriber& s) { return s.id == fds[i].fd; });
+            if (found == subscribers_.end()) {
+                continue;
+            }
+            if (fds[i].revents & POLLIN) {
+                receive_(*found);
+            } else {
+                close_(*found);
+            }
+        }
+        subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+                                          [](const Subscriber& s) { return s.id < 0; }),
+                           subscribers_.end());
+    }
+}
+
+void FrameServer::reserve_(Slot& slot, const std::size_t size) {
+    if (slot.fd < 0) {
+        slot.fd = memfd_create("camera-frame", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (slot.fd < 0) {
+            throw systemError("memfd_create");
+        }
+        // subscribers get a read-only descriptor, and the memfd never shrinks under their mappings
+        slot.read_fd = open(("/proc/self/fd/" + std::to_string(slot.fd)).c_str(), O_RDONLY | O_CLOEXEC);
+        if (slot.read_fd < 0 || fcntl(slot.fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) {
+            const auto error = systemError("memfd");
+            close(slot.read_fd);
+            close(slot.fd);
+            slot.fd = slot.read_fd = -1;
+            throw error;
+        }
+    }
+    if (size <= slot.capacity) {
+        return;
+    }
+
+    if (slot.data != nullptr) {
+        munmap(slot.data, slot.capacity);
+        slot.data     = nullptr;
+        slot.capacity = 0;
+    }
+    if (ftruncate(slot.fd, static_cast<off_t>(size)) != 0) {
+        throw systemError("ftruncate");
+    }
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, slot.fd, 0);
+    if (mapped == MAP_FAILED) {
+        throw systemError("mmap");
+    }
+    slot.data     = static_cast<uint8_t*>(mapped);
+    slot.capacity = size;
+}
+
+void FrameServer::accept_() {
+    const int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+    if (fd < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (subscribers_.size() >= max_subscribers_) {
+        close(fd);
+        return;
+    }
+    Subscriber subscriber;
+    subscriber.id = fd;
+    subscribers_.push_back(subscriber);
+}
+
+void FrameServer::receive_(Subscriber& subscriber) {
+    wire::CreditMessage message{};
+    while (true) {
+        const auto n = recv(subscriber.id, &message, sizeof(message), MSG_DONTWAIT);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (n != static_cast<ssize_t>(sizeof(message)) || message.magic != wire::kCreditMagic) {
+            close_(subscriber);  // disconnected or speaking another protocol
+            return;
+        }
+        subscriber.credits += message.credits;
+        if (message.slot < slots_.size()) {
+            auto&      holders = slots_[message.slot].holders;
+            const auto found   = std::find(holders.begin(), holders.end(), subscriber.id);
+            if (found != holders.end()) {
+                holders.erase(found);
+            }
+        }
+    }
+}
+
+void FrameServer::close_(Subscriber& subscriber) {
+    for (auto& slot : slots_) {  // frames of a subscriber which is gone are released with it
+        slot.holders.erase(std::remove(slot.holders.begin(), slot.holders.end(), subscriber.id), slot.holders.end());
+    }
+    close(subscriber.id);
+    subscriber.id = -1;
+}
+
+/**
+ * @brief Socket of a client, which the frames it received keep open to return their credits.
+ */
+class FrameClient::Connection {
+   public:
+    explicit Connection(const int fd)
+        : fd_(fd) {}
+    ~Connection() { close(fd_); }
+
+    Connection(const Connection&)            = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    int fd() const { return fd_; }
+
+    /**
+     * @return false if the server is gone.
+     */
+    bool grant(const uint32_t credits, const uint32_t slot) {
+        const wire::CreditMessage   message{wire::kCreditMagic, credits, slot};
+        std::lock_guard<std::mutex> lock(mutex_);
+        return send(fd_, &message, sizeof(message), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(message));
+    }
+
+   private:
+    int        fd_;
+    std::mutex mutex_;  // frames may be released from any thread
+};
+
+FrameClient::FrameClient(const std::string& path, const uint32_t credits) {
+    const auto addr = addressOf(path);
+
+    const int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw systemError("socket");
+    }
+    connection_ = std::make_shared<Connection>(fd);
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw systemError("connect " + path);
+    }
+    if (!connection_->grant(credits, wire::kNoSlot)) {
+        throw systemError("send");
+    }
+}
+
+FrameClient::~FrameClient() = default;
+
+std::shared_ptr<IImage> FrameClient::receive(const int64_t timeout_ms) {
+    pollfd pfd{connection_->fd(), POLLIN, 0};
+    const int ready = poll(&pfd, 1, static_cast<int>(timeout_ms));
+    if (ready == 0) {
+        throw exception::Timeout();
+    }
+    if (ready < 0 || (pfd.revents & POLLIN) == 0) {
+        throw exception::DeviceNotConnected();
+    }
+
+    wire::FrameMessage message{};
+    iovec              iov{&message, sizeof(message)};
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    msghdr msg{};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    const auto n = recvmsg(connection_->fd(), &msg, MSG_CMSG_CLOEXEC);
+    if (n <= 0) {
+        throw exception::DeviceNotConnected();
+    }
+
+    int      fd   = -1;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    if (n != static_cast<ssize_t>(sizeof(message)) || message.magic != wire::kFrameMagic || fd < 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw exception::GenericException("malformed frame message");
+    }
+
+    auto image          = std::make_shared<IImage>();
+    image->complete     = (message.complete != 0);
+    image->header.stamp = message.stamp;
+    image->header.seq   = message.seq;
+    image->rows         = message.rows;
+    image->cols         = message.cols;
+    image->step         = message.step;
+    image->depth        = message.depth;
+
+    if (message.size == 0) {
+        close(fd);
+        connection_->grant(1, message.slot);
+        return image;
+    }
+    void* mapped = mmap(nullptr, message.size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        const auto error = systemError("mmap");
+        close(fd);
+        connection_->grant(1, message.slot);
+        throw error;
+    }
+    close(fd);  // the mapping keeps the memfd
+
+    // the frame is a view of the slot, which is returned to the server once the frame is released
+    const auto connection = connection_;
+    const auto size       = message.size;
+    const auto slot       = message.slot;
+    const auto release    = [connection, size, slot](uint8_t* ptr) {
+        munmap(ptr, size);
+        connection->grant(1, slot);  // a server which is gone takes no credits back
+    };
+    image->data = Buffer(static_cast<uint8_t*>(mapped), BufferDeleter(release));
+    return image;
+}
+
+}  // namespace camera
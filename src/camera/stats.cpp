@@ -0,0 +1,89 @@
+#include <utility>
+
+#include "camera/clock.hpp"
+#include "camera/stats.h"
+
+namespace camera {
+
+StatsRecorder::StatsRecorder(const int64_t interval_ns)
+    : interval_ns_(interval_ns) {}
+
+void StatsRecorder::setStreamSampler(StreamSampler sampler) {
+    sampler_ = std::move(sampler);
+}
+
+void StatsRecorder::frame(const uint64_t bytes, const bool complete, const int64_t wait_ns, const int64_t copy_ns) {
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    if (!complete) {
+        incomplete_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+    copy_ns_.fetch_add(copy_ns, std::memory_order_relaxed);
+    tick_();
+}
+
+void StatsRecorder::underrun(const int64_t wait_ns) {
+    underruns_.fetch_add(1, std::memory_order_relaxed);
+    wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+    tick_();  // a starved stream is still sampled, which is when its lost frames matter most
+}
+
+void StatsRecorder::restart() {
+    past_lost_frames_.fetch_add(lost_frames_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    past_missed_packets_.fetch_add(missed_packets_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    past_resend_requests_.fetch_add(resend_requests_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+DeviceStats StatsRecorder::snapshot() const {
+    const auto total = [](const std::atomic<int64_t>& past, const std::atomic<int64_t>& current) {
+        return static_cast<uint64_t>(past.load(std::memory_order_relaxed) + current.load(std::memory_order_relaxed));
+    };
+
+    DeviceStats stats;
+    stats.frames          = frames_.load(std::memory_order_relaxed);
+    stats.bytes           = bytes_.load(std::memory_order_relaxed);
+    stats.incomplete      = incomplete_.load(std::memory_order_relaxed);
+    stats.underruns       = underruns_.load(std::memory_order_relaxed);
+    stats.wait_ns         = wait_ns_.load(std::memory_order_relaxed);
+    stats.copy_ns         = copy_ns_.load(std::memory_order_relaxed);
+    stats.lost_frames     = total(past_lost_frames_, lost_frames_);
+    stats.missed_packets  = total(past_missed_packets_, missed_packets_);
+    stats.resend_requests = total(past_resend_requests_, resend_requests_);
+
+    // the rates are only updated by captures, delivered or timed out, so they are stale once nobody captures
+    if (steadyNs() - sampled_ns_.load(std::memory_order_relaxed) < 2 * interval_ns_) {
+        stats.fps              = fps_.load(std::memory_order_relaxed);
+        stats.bytes_per_second = bytes_per_second_.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void StatsRecorder::tick_() {
+    const auto now_ns = steadyNs();
+    if (now_ns - sampled_ns_.load(std::memory_order_relaxed) >= interval_ns_) {
+        sample_(now_ns);
+    }
+}
+
+void StatsRecorder::sample_(const int64_t now_ns) {
+    const auto last_ns    = sampled_ns_.exchange(now_ns, std::memory_order_relaxed);
+    const auto frames     = frames_.load(std::memory_order_relaxed);
+    const auto bytes      = bytes_.load(std::memory_order_relaxed);
+    const auto elapsed_s  = static_cast<double>(now_ns - last_ns) / 1e9;
+    const auto new_frames = frames - sampled_frames_.exchange(frames, std::memory_order_relaxed);
+    const auto new_bytes  = bytes - sampled_bytes_.exchange(bytes, std::memory_order_relaxed);
+    if (last_ns != 0 && elapsed_s > 0.0) {  // the first sample only sets the baseline
+        fps_.store(static_cast<double>(new_frames) / elapsed_s, std::memory_order_relaxed);
+        bytes_per_second_.store(static_cast<double>(new_bytes) / elapsed_s, std::memory_order_relaxed);
+    }
+
+    StreamCounters counters;
+    if (sampler_ && sampler_(counters)) {
+        lost_frames_.store(counters.lost_frames, std::memory_order_relaxed);
+        missed_packets_.store(counters.missed_packets, std::memory_order_relaxed);
+        resend_requests_.store(counters.resend_requests, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace camera
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// brought in by the headers of the SDK, which the library relies on
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "GenApi/GenApi.h"
+
+/**
+ * @brief In-process stand-in of the Arena SDK, as far as the library uses it, so that the benchmarks run without a
+ *      camera or the SDK.
+ *
+ * @details
+ * the system holds a single color camera of 1936x1464 pixels. its nodes are kept in memory with the names and types
+ * the library expects, and its stream always has a frame ready: `IDevice::GetImage()` hands out the next idle
+ * buffer without waiting, and only times out once every buffer is held by the caller. the buffers are allocated and
+ * filled by `IDevice::StartStream()`, from the width, height and pixel format set at that time.
+ */
+
+typedef enum PfncFormat_
+{
+    Mono8     = 0x01080001,
+    Mono16    = 0x01100007,
+    BayerRG8  = 0x01080009,
+    BayerRG16 = 0x0110002F,
+    RGB8      = 0x02180014,
+    BGR8      = 0x02180015,
+} PfncFormat;
+
+namespace Arena {
+
+class DeviceInfo {
+   public:
+    explicit DeviceInfo(std::string model = "TRI028S-C", std::string serial = "000000001")
+        : model_(std::move(model))
+        , serial_(std::move(serial)) {}
+
+    GenICam::gcstring ModelName() const { return model_; }
+    GenICam::gcstring VendorName() const { return "Lucid Vision Labs"; }
+    GenICam::gcstring SerialNumber() const { return serial_; }
+    GenICam::gcstring DeviceVersion() const { return "1.0.0.0"; }
+    GenICam::gcstring UserDefinedName() const { return ""; }
+    GenICam::gcstring IpAddressStr() const { return "169.254.0.2"; }
+    GenICam::gcstring SubnetMaskStr() const { return "255.255.0.0"; }
+    GenICam::gcstring DefaultGatewayStr() const { return "0.0.0.0"; }
+    GenICam::gcstring MacAddressStr() const { return "1c:0f:af:00:00:01"; }
+    uint32_t          IpAddress() const { return 0xA9FE0002; }
+    uint32_t          SubnetMask() const { return 0xFFFF0000; }
+    uint32_t          DefaultGateway() const { return 0; }
+    uint64_t          MacAddress() const { return 0x1C0FAF000001; }
+    bool              IsDHCPConfigurationEnabled() const { return false; }
+    bool              IsPersistentIpConfigurationEnabled() const { return false; }
+    bool              IsLLAConfigurationEnabled() const { return true; }
+
+   private:
+    std::string model_;
+    std::string serial_;
+};
+
+class IChunkData;
+
+class IBuffer {
+   public:
+    explicit IBuffer(const std::size_t size)
+        : data_(size) {}
+    virtual ~IBuffer() = default;
+
+    const uint8_t* GetData() const { return data_.data(); }
+    std::size_t    GetSizeFilled() const { return data_.size(); }
+    std::size_t    GetPayloadSize() const { return data_.size(); }
+    std::size_t    GetSizeOfBuffer() const { return data_.size(); }
+    uint64_t       GetFrameId() const { return frame_id_; }
+    bool           IsIncomplete() const { return false; }
+    bool           HasImageData() const { return true; }
+    bool           HasChunkData() const { return false; }
+    IChunkData*    AsChunkData() { return nullptr; }
+    bool           DataLargerThanBuffer() const { return false; }
+
+   protected:
+    friend class IDevice;
+
+    std::vector<uint8_t> data_;
+    uint64_t             frame_id_  = 0;
+    uint64_t             timestamp_ = 0;
+};
+
+class IImage: public IBuffer {
+   public:
+    IImage(const std::size_t width, const std::size_t height, const uint64_t pixel_format)
+        : IBuffer(width * height * ((pixel_format >> 16) & 0xFF) / 8)
+        , width_(width)
+        , height_(height)
+        , pixel_format_(pixel_format) {}
+
+    std::size_t GetWidth() const { return width_; }
+    std::size_t GetHeight() const { return height_; }
+    std::size_t GetBitsPerPixel() const { return (pixel_format_ >> 16) & 0xFF; }  // encoded in the PFNC value
+    uint64_t    GetPixelFormat() const { return pixel_format_; }
+    uint64_t    GetTimestamp() const { return timestamp_; }
+    uint64_t    GetTimestampNs() const { return timestamp_; }
+
+   private:
+    std::size_t width_;
+    std::size_t height_;
+    uint64_t    pixel_format_;
+};
+
+class IChunkData: public IBuffer {
+   public:
+    using IBuffer::IBuffer;
+
+    GenApi::INode* GetChunk(const GenICam::gcstring& /*name*/) { return nullptr; }
+};
+
+class IDevice {
+   public:
+    static constexpr int64_t kWidthMax  = 1936;
+    static constexpr int64_t kHeightMax = 1464;
+
+    IDevice() {
+        using namespace GenApi;
+        const std::vector<std::string> off_on        = {"Off", "On"};
+        const std::vector<std::string> off_auto      = {"Off", "Continuous"};
+        const std::vector<std::string> binning_modes = {"Sum", "Average"};
+        const std::vector<std::string> user_sets     = {"Default", "UserSet1", "UserSet2"};
+
+        node_map_.AddNode<IInteger>("ActionCommandExecuteTime", 0);
+        node_map_.AddNode<IInteger>("ActionDeviceKey", 0);
+        node_map_.AddNode<IInteger>("ActionGroupKey", 0);
+        node_map_.AddNode<IInteger>("ActionGroupMask", 0);
+        node_map_.AddNode<IInteger>("ActionQueueSize", 9);
+        node_map_.AddNode<IInteger>("ActionSelector", 0, 0, 0);
+        node_map_.AddNode<IEnumeration>("ActionUnconditionalMode", off_on);
+        node_map_.AddNode<IFloat>("AcquisitionFrameRate", 30.0);
+        node_map_.AddNode<IBoolean>("AcquisitionFrameRateEnable", false);
+        node_map_.AddNode<IEnumeration>("AcquisitionMode",
+                                        std::vector<std::string>{"Continuous", "SingleFrame", "MultiFrame"});
+        node_map_.AddNode<IEnumeration>("AcquisitionStartMode", std::vector<std::string>{"Normal", "LowLatency"});
+        node_map_.AddNode<IInteger>("BinningHorizontal", 1, 1, 8);
+        node_map_.AddNode<IEnumeration>("BinningHorizontalMode", binning_modes);
+        node_map_.AddNode<IEnumeration>("BinningSelector", std::vector<std::string>{"Digital", "Sensor"});
+        node_map_.AddNode<IInteger>("BinningVertical", 1, 1, 8);
+        node_map_.AddNode<IEnumeration>("BinningVerticalMode", binning_modes);
+        node_map_.AddNode<IBoolean>("ChunkEnable", false);
+        node_map_.AddNode<IBoolean>("ChunkModeActive", false);
+        node_map_.AddNode<IEnumeration>(
+            "ChunkSelector", std::vector<std::string>{"CRC", "ExposureTime", "FrameCounter", "Gain", "Timestamp"});
+        node_map_.AddNode<IInteger>("DeviceLinkSpeed", 125000000);
+        node_map_.AddNode<IFloat>("DeviceTemperature", 45.0);
+        node_map_.AddNode<IEnumeration>("ExposureAuto", off_auto);
+        node_map_.AddNode<IEnumeration>("ExposureAutoLimitAuto", off_auto);
+        node_map_.AddNode<IFloat>("ExposureAutoLowerLimit", 20.56);
+        node_map_.AddNode<IFloat>("ExposureAutoUpperLimit", 25000.0);
+        node_map_.AddNode<IFloat>("ExposureTime", 500.0);
+        node_map_.AddNode<IEnumeration>("GainAuto", off_auto);
+        node_map_.AddNode<IBoolean>("GevCurrentIPConfigurationDHCP", false);
+        node_map_.AddNode<IBoolean>("GevCurrentIPConfigurationLLA", true);
+        node_map_.AddNode<IBoolean>("GevCurrentIPConfigurationPersistentIP", false);
+        node_map_.AddNode<IInteger>("GevMCDA", 0);
+        node_map_.AddNode<IBoolean>("GevPersistentARPConflictDetectionEnable", true);
+        node_map_.AddNode<IInteger>("GevPersistentIPAddress", 0);
+        node_map_.AddNode<IInteger>("GevPersistentSubnetMask", 0);
+        node_map_.AddNode<IInteger>("GevSCDA", 0);
+        node_map_.AddNode<IInteger>("GevSCPD", 80);
+        node_map_.AddNode<IInteger>("GevSCPSPacketSize", 1500, 576, 9000);
+        node_map_.AddNode<IInteger>("Height", kHeightMax, 1, kHeightMax);
+        node_map_.AddNode<IInteger>("HeightMax", kHeightMax);
+        node_map_.AddNode<IInteger>("PayloadSize", kWidthMax * kHeightMax);
+        node_map_.AddNode<IEnumeration>(
+            "PixelFormat", std::vector<std::string>{"BayerRG8", "BayerRG16", "Mono8", "Mono16", "RGB8", "BGR8"});
+        node_map_.AddNode<IBoolean>("PtpEnable", false);
+        node_map_.AddNode<IInteger>("PtpOffsetFromMaster", 0);
+        node_map_.AddNode<IBoolean>("PtpSlaveOnly", false);
+        node_map_.AddNode<IEnumeration>("PtpStatus", std::vector<std::string>{"Disabled", "Master", "Slave"});
+        node_map_.AddNode<IBoolean>("ReverseX", false);
+        node_map_.AddNode<IBoolean>("ReverseY", false);
+        node_map_.AddNode<IInteger>("TargetBrightness", 70, 0, 255);
+        node_map_.AddNode<ICommand>("TimestampLatch");
+        node_map_.AddNode<IInteger>("TimestampLatchValue", 0);
+        node_map_.AddNode<IEnumeration>("TransferControlMode",
+                                        std::vector<std::string>{"Basic", "Automatic", "UserControlled"});
+        node_map_.AddNode<IEnumeration>("TransferOperationMode", std::vector<std::string>{"Continuous", "MultiBlock"});
+        node_map_.AddNode<IEnumeration>("TransferSelector", std::vector<std::string>{"Stream0"});
+        node_map_.AddNode<ICommand>("TransferStart");
+        node_map_.AddNode<ICommand>("TransferStop");
+        node_map_.AddNode<IEnumeration>("TriggerActivation",
+                                        std::vector<std::string>{"RisingEdge", "FallingEdge", "AnyEdge"});
+        node_map_.AddNode<IBoolean>("TriggerArmed", false);
+        node_map_.AddNode<IFloat>("TriggerDelay", 0.0);
+        node_map_.AddNode<IEnumeration>("TriggerLatency", std::vector<std::string>{"Off", "OneLine"});
+        node_map_.AddNode<IEnumeration>("TriggerMode", off_on);
+        node_map_.AddNode<IEnumeration>("TriggerOverlap", std::vector<std::string>{"Off", "ReadOut", "PreviousFrame"});
+        node_map_.AddNode<IEnumeration>("TriggerSelector",
+                                        std::vector<std::string>{"AcquisitionStart", "FrameStart", "FrameBurstStart"});
+        node_map_.AddNode<IEnumeration>("TriggerSource", std::vector<std::string>{"Software", "Line0", "Action0"});
+        node_map_.AddNode<IEnumeration>("UserSetDefault", user_sets);
+        node_map_.AddNode<ICommand>("UserSetLoad");
+        node_map_.AddNode<ICommand>("UserSetSave");
+        node_map_.AddNode<IEnumeration>("UserSetSelector", user_sets);
+        node_map_.AddNode<IInteger>("Width", kWidthMax, 1, kWidthMax);
+        node_map_.AddNode<IInteger>("WidthMax", kWidthMax);
+
+        stream_node_map_.AddNode<IBoolean>("StreamAutoNegotiatePacketSize", true);
+        stream_node_map_.AddNode<IEnumeration>(
+            "StreamBufferHandlingMode", std::vector<std::string>{"OldestFirst", "OldestFirstOverwrite", "NewestOnly"});
+        stream_node_map_.AddNode<IInteger>("StreamLostFrameCount", 0);
+        stream_node_map_.AddNode<IInteger>("StreamMissedPacketCount", 0);
+        stream_node_map_.AddNode<IBoolean>("StreamMulticastEnable", false);
+        stream_node_map_.AddNode<IBoolean>("StreamPacketResendEnable", true);
+        stream_node_map_.AddNode<IInteger>("StreamResendRequestCount", 0);
+
+        device_node_map_.AddNode<IEnumeration>("DeviceAccessStatus",
+                                               std::vector<std::string>{"ReadWrite", "ReadOnly", "NoAccess"});
+    }
+
+    GenApi::INodeMap* GetNodeMap() { return &node_map_; }
+    GenApi::INodeMap* GetTLDeviceNodeMap() { return &device_node_map_; }
+    GenApi::INodeMap* GetTLStreamNodeMap() { return &stream_node_map_; }
+
+    void StartStream(const std::size_t num_buffers = 10) {
+        if (!buffers_.empty()) {
+            throw GenICam::GenericException("the stream is already started");
+        }
+        const auto width  = static_cast<std::size_t>(integerOf_("Width"));
+        const auto height = static_cast<std::size_t>(integerOf_("Height"));
+        const auto format = pixelFormatOf_();
+        for (std::size_t i = 0; i < std::max<std::size_t>(num_buffers, 1); i++) {
+            auto image = std::make_unique<IImage>(width, height, format);
+            for (std::size_t j = 0; j < image->data_.size(); j++) {
+                image->data_[j] = static_cast<uint8_t>(j * 7 + i);  // touches every page before the first frame
+            }
+            ready_.push_back(image.get());
+            buffers_.push_back(std::move(image));
+        }
+    }
+
+    void StopStream() {
+        ready_.clear();
+        buffers_.clear();
+    }
+
+    IImage* GetImage(const uint64_t /*timeout_ms*/) {
+        if (ready_.empty()) {
+            throw GenICam::TimeoutException("every buffer of the stream is held by the application");
+        }
+        auto* const image = ready_.front();
+        ready_.pop_front();
+        image->frame_id_  = ++frame_id_;
+        image->timestamp_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::steady_clock::now().time_since_epoch())
+                                                      .count());
+        return image;
+    }
+
+    void RequeueBuffer(IBuffer* buffer) {
+        auto* const image = dynamic_cast<IImage*>(buffer);
+        if (image == nullptr) {
+            throw GenICam::InvalidArgumentException("the buffer does not belong to the stream");
+        }
+        ready_.push_back(image);
+    }
+
+    bool IsConnected() const { return true; }
+
+   private:
+    int64_t integerOf_(const char* name) const {
+        return GenApi::CIntegerPtr(node_map_.GetNode(name))->GetValue();
+    }
+
+    uint64_t pixelFormatOf_() const {
+        const auto format = GenApi::CEnumerationPtr(node_map_.GetNode("PixelFormat"))->ToString();
+        if (format == "BayerRG16") {
+            return BayerRG16;
+        } else if (format == "Mono8") {
+            return Mono8;
+        } else if (format == "Mono16") {
+            return Mono16;
+        } else if (format == "RGB8") {
+            return RGB8;
+        } else if (format == "BGR8") {
+            return BGR8;
+        }
+        return BayerRG8;
+    }
+
+    GenApi::INodeMap node_map_;
+    GenApi::INodeMap stream_node_map_;
+    GenApi::INodeMap device_node_map_;
+
+    std::vector<std::unique_ptr<IImage>> buffers_;
+    std::deque<IImage*>                  ready_;
+    uint64_t                             frame_id_ = 0;
+};
+
+class ISystem {
+   public:
+    void                    UpdateDevices(const uint64_t /*timeout_ms*/) {}
+    std::vector<DeviceInfo> GetDevices() const { return {DeviceInfo()}; }
+
+    IDevice* CreateDevice(const DeviceInfo& /*info*/) {
+        devices_.push_back(std::make_unique<IDevice>());
+        return devices_.back().get();
+    }
+
+    void DestroyDevice(IDevice* device) {
+        const auto is_device = [device](const std::unique_ptr<IDevice>& owned) { return owned.get() == device; };
+        devices_.erase(std::remove_if(devices_.begin(), devices_.end(), is_device), devices_.end());
+    }
+
+    GenApi::INodeMap* GetTLSystemNodeMap() { return &system_node_map_; }
+    GenApi::INodeMap* GetTLInterfaceNodeMap(const DeviceInfo& /*info*/) { return &interface_node_map_; }
+
+    void ForceIp(const uint64_t /*mac*/, const uint64_t /*ip*/, const uint64_t /*subnet*/, const uint64_t /*gw*/) {}
+
+   private:
+    GenApi::INodeMap                      system_node_map_;
+    GenApi::INodeMap                      interface_node_map_;
+    std::vector<std::unique_ptr<IDevice>> devices_;
+};
+
+inline ISystem* OpenSystem() {
+    return new ISystem();
+}
+
+inline void CloseSystem(ISystem* system) {
+    delete system;
+}
+
+namespace detail {
+inline GenApi::INode* nodeOf(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    auto* const node = (node_map != nullptr) ? node_map->GetNode(name) : nullptr;
+    if (node == nullptr) {
+        throw GenICam::GenericException(name.str() + " is not found");
+    }
+    return node;
+}
+
+template<typename P>
+P typedNodeOf(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    P node = nodeOf(node_map, name);
+    if (!node) {
+        throw GenICam::InvalidArgumentException(name.str() + " is not of the requested type");
+    }
+    return node;
+}
+}  // namespace detail
+
+template<typename T>
+T GetNodeValue(GenApi::INodeMap* node_map, const GenICam::gcstring& name);
+
+template<typename T>
+void SetNodeValue(GenApi::INodeMap* node_map, const GenICam::gcstring& name, T value);
+
+template<>
+inline int64_t GetNodeValue<int64_t>(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    return detail::typedNodeOf<GenApi::CIntegerPtr>(node_map, name)->GetValue();
+}
+
+template<>
+inline double GetNodeValue<double>(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    return detail::typedNodeOf<GenApi::CFloatPtr>(node_map, name)->GetValue();
+}
+
+template<>
+inline bool GetNodeValue<bool>(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    return detail::typedNodeOf<GenApi::CBooleanPtr>(node_map, name)->GetValue();
+}
+
+template<>
+inline GenICam::gcstring GetNodeValue<GenICam::gcstring>(GenApi::INodeMap*        node_map,
+                                                         const GenICam::gcstring& name) {
+    const GenApi::CEnumerationPtr enumeration = detail::nodeOf(node_map, name);
+    if (enumeration) {
+        return enumeration->ToString();
+    }
+    return detail::typedNodeOf<GenApi::CStringPtr>(node_map, name)->GetValue();
+}
+
+template<>
+inline void SetNodeValue<int64_t>(GenApi::INodeMap* node_map, const GenICam::gcstring& name, int64_t value) {
+    detail::typedNodeOf<GenApi::CIntegerPtr>(node_map, name)->SetValue(value);
+}
+
+template<>
+inline void SetNodeValue<double>(GenApi::INodeMap* node_map, const GenICam::gcstring& name, double value) {
+    detail::typedNodeOf<GenApi::CFloatPtr>(node_map, name)->SetValue(value);
+}
+
+template<>
+inline void SetNodeValue<bool>(GenApi::INodeMap* node_map, const GenICam::gcstring& name, bool value) {
+    detail::typedNodeOf<GenApi::CBooleanPtr>(node_map, name)->SetValue(value);
+}
+
+template<>
+inline void SetNodeValue<GenICam::gcstring>(GenApi::INodeMap* node_map, const GenICam::gcstring& name,
+                                            GenICam::gcstring value) {
+    const GenApi::CEnumerationPtr enumeration = detail::nodeOf(node_map, name);
+    if (enumeration) {
+        enumeration->FromString(value);
+        return;
+    }
+    detail::typedNodeOf<GenApi::CStringPtr>(node_map, name)->SetValue(value);
+}
+
+inline void ExecuteNode(GenApi::INodeMap* node_map, const GenICam::gcstring& name) {
+    detail::typedNodeOf<GenApi::CCommandPtr>(node_map, name)->Execute();
+}
+
+}  // namespace Arena
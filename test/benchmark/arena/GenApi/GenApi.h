@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief In-process stand-in of the GenICam node API, as far as the library uses it.
+ *      Nodes hold their values in memory, so reading and writing them costs what the host side of the library costs,
+ *      without any register access on a device.
+ */
+
+namespace GenICam {
+
+class gcstring {
+   public:
+    gcstring() = default;
+    gcstring(const char* value)
+        : value_(value != nullptr ? value : "") {}
+    gcstring(std::string value)
+        : value_(std::move(value)) {}
+
+    const char*        c_str() const { return value_.c_str(); }
+    const std::string& str() const { return value_; }
+    operator const char*() const { return value_.c_str(); }
+
+    bool operator==(const gcstring& other) const { return value_ == other.value_; }
+    bool operator!=(const gcstring& other) const { return value_ != other.value_; }
+    bool operator==(const char* other) const { return value_ == other; }
+    bool operator!=(const char* other) const { return value_ != other; }
+
+   private:
+    std::string value_;
+};
+
+class GenericException: public std::exception {
+   public:
+    explicit GenericException(const char* description = "", const char* /*file*/ = "", int /*line*/ = 0)
+        : description_(description) {}
+    explicit GenericException(const std::string& description)
+        : description_(description) {}
+
+    const char* what() const noexcept override { return description_.c_str(); }
+
+   private:
+    std::string description_;
+};
+
+class AccessException: public GenericException {
+    using GenericException::GenericException;
+};
+
+class TimeoutException: public GenericException {
+    using GenericException::GenericException;
+};
+
+class InvalidArgumentException: public GenericException {
+    using GenericException::GenericException;
+};
+
+}  // namespace GenICam
+
+namespace GenApi {
+
+class INode {
+   public:
+    explicit INode(std::string name)
+        : name_(std::move(name)) {}
+    virtual ~INode() = default;
+
+    GenICam::gcstring GetName() const { return name_; }
+
+   private:
+    std::string name_;
+};
+
+class IInteger: public INode {
+   public:
+    IInteger(std::string name, const int64_t value, const int64_t min = 0, const int64_t max = INT64_MAX)
+        : INode(std::move(name))
+        , value_(value)
+        , min_(min)
+        , max_(max) {}
+
+    int64_t GetValue(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const { return value_; }
+    int64_t GetMin() const { return min_; }
+    int64_t GetMax() const { return max_; }
+    int64_t GetInc() const { return 1; }
+
+    void SetValue(const int64_t value, bool /*verify*/ = true) {
+        if (value < min_ || value > max_) {
+            throw GenICam::InvalidArgumentException(GetName().str() + " is out of range");
+        }
+        value_ = value;
+    }
+
+   private:
+    int64_t value_;
+    int64_t min_;
+    int64_t max_;
+};
+
+class IFloat: public INode {
+   public:
+    IFloat(std::string name, const double value)
+        : INode(std::move(name))
+        , value_(value) {}
+
+    double GetValue(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const { return value_; }
+    void   SetValue(const double value, bool /*verify*/ = true) { value_ = value; }
+
+   private:
+    double value_;
+};
+
+class IBoolean: public INode {
+   public:
+    IBoolean(std::string name, const bool value)
+        : INode(std::move(name))
+        , value_(value) {}
+
+    bool GetValue(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const { return value_; }
+    void SetValue(const bool value, bool /*verify*/ = true) { value_ = value; }
+
+   private:
+    bool value_;
+};
+
+class IString: public INode {
+   public:
+    IString(std::string name, std::string value)
+        : INode(std::move(name))
+        , value_(std::move(value)) {}
+
+    GenICam::gcstring GetValue(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const { return value_; }
+    void              SetValue(const GenICam::gcstring& value, bool /*verify*/ = true) { value_ = value.str(); }
+
+   private:
+    std::string value_;
+};
+
+class ICommand: public INode {
+   public:
+    using INode::INode;
+
+    void     Execute(bool /*verify*/ = true) { executions_++; }
+    bool     IsDone(bool /*verify*/ = true) const { return true; }
+    uint64_t GetExecutions() const { return executions_; }
+
+   private:
+    uint64_t executions_ = 0;
+};
+
+class IEnumEntry: public INode {
+   public:
+    IEnumEntry(std::string symbolic, const int64_t value)
+        : INode(symbolic)
+        , symbolic_(std::move(symbolic))
+        , value_(value) {}
+
+    int64_t           GetValue() const { return value_; }
+    GenICam::gcstring GetSymbolic() const { return symbolic_; }
+
+   private:
+    std::string symbolic_;
+    int64_t     value_;
+};
+
+/**
+ * @brief Enumeration whose entries are valued by their position, and which starts at its first entry.
+ */
+class IEnumeration: public INode {
+   public:
+    IEnumeration(std::string name, const std::vector<std::string>& symbolics)
+        : INode(std::move(name)) {
+        for (const auto& symbolic : symbolics) {
+            entries_.push_back(std::make_unique<IEnumEntry>(symbolic, static_cast<int64_t>(entries_.size())));
+        }
+    }
+
+    IEnumEntry* GetEntryByName(const GenICam::gcstring& symbolic) const {
+        for (const auto& entry : entries_) {
+            if (entry->GetSymbolic() == symbolic) {
+                return entry.get();
+            }
+        }
+        return nullptr;
+    }
+
+    IEnumEntry* GetCurrentEntry(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const {
+        return entries_.at(current_).get();
+    }
+
+    int64_t GetIntValue(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const {
+        return GetCurrentEntry()->GetValue();
+    }
+
+    void SetIntValue(const int64_t value, bool /*verify*/ = true) {
+        if (value < 0 || value >= static_cast<int64_t>(entries_.size())) {
+            throw GenICam::InvalidArgumentException(GetName().str() + " has no entry of the value");
+        }
+        current_ = static_cast<std::size_t>(value);
+    }
+
+    void FromString(const GenICam::gcstring& symbolic, bool /*verify*/ = true) {
+        const auto* const entry = GetEntryByName(symbolic);
+        if (entry == nullptr) {
+            throw GenICam::InvalidArgumentException(GetName().str() + " has no entry " + symbolic.str());
+        }
+        current_ = static_cast<std::size_t>(entry->GetValue());
+    }
+
+    GenICam::gcstring ToString(bool /*verify*/ = false, bool /*ignore_cache*/ = false) const {
+        return GetCurrentEntry()->GetSymbolic();
+    }
+
+   private:
+    std::vector<std::unique_ptr<IEnumEntry>> entries_;
+    std::size_t                              current_ = 0;
+};
+
+/**
+ * @brief Smart pointer to a node of a given interface, which is null if the node does not implement it.
+ */
+template<typename T>
+class CPointer {
+   public:
+    CPointer() = default;
+    CPointer(INode* node)
+        : node_(dynamic_cast<T*>(node)) {}
+
+    T*   operator->() const { return node_; }
+    T&   operator*() const { return *node_; }
+    bool IsValid() const { return node_ != nullptr; }
+         operator bool() const { return node_ != nullptr; }
+
+   private:
+    T* node_ = nullptr;
+};
+
+using CIntegerPtr     = CPointer<IInteger>;
+using CFloatPtr       = CPointer<IFloat>;
+using CBooleanPtr     = CPointer<IBoolean>;
+using CStringPtr      = CPointer<IString>;
+using CCommandPtr     = CPointer<ICommand>;
+using CEnumerationPtr = CPointer<IEnumeration>;
+using CEnumEntryPtr   = CPointer<IEnumEntry>;
+
+inline bool IsReadable(const INode* node) {
+    return node != nullptr;
+}
+
+inline bool IsWritable(const INode* node) {
+    return node != nullptr;
+}
+
+inline bool IsAvailable(const INode* node) {
+    return node != nullptr;
+}
+
+template<typename T>
+bool IsReadable(const CPointer<T>& node) {
+    return node.IsValid();
+}
+
+template<typename T>
+bool IsWritable(const CPointer<T>& node) {
+    return node.IsValid();
+}
+
+template<typename T>
+bool IsAvailable(const CPointer<T>& node) {
+    return node.IsValid();
+}
+
+class INodeMap {
+   public:
+    /**
+     * @return nullptr if the map holds no node of the name.
+     */
+    INode* GetNode(const GenICam::gcstring& name) const {
+        const auto node = nodes_.find(name.str());
+        return (node != nodes_.end()) ? node->second.get() : nullptr;
+    }
+
+    /**
+     * @brief Adds a node to the map, replacing a node of the same name. Not a part of GenApi.
+     */
+    template<typename T, typename... Args>
+    T* AddNode(const std::string& name, Args&&... args) {
+        auto  node   = std::make_unique<T>(name, std::forward<Args>(args)...);
+        auto* result = node.get();
+        nodes_[name] = std::move(node);
+        return result;
+    }
+
+   private:
+    std::unordered_map<std::string, std::unique_ptr<INode>> nodes_;
+};
+
+}  // namespace GenApi
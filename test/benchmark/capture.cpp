@@ -0,0 +1,131 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "camera/api/lucid.h"
+
+/**
+ * @details
+ * measures `camera::lucid::Device::capture()` against the in-process stand-in of the Arena SDK, whose stream always
+ * has a frame ready, so that the numbers hold the cost of the host side of a capture: taking a buffer from the pool,
+ * copying the frame out of the stream, and the bookkeeping of every frame.
+ * a plain copy of the same size is measured next to every capture, which separates the copy from the rest.
+ */
+
+namespace {
+struct Resolution {
+    int64_t width;
+    int64_t height;
+};
+
+const std::vector<Resolution> kResolutions = {{640, 480}, {1280, 960}, {1936, 1464}};
+
+std::string nameOf(const std::string& what, const std::string& pixel_format, const Resolution& resolution) {
+    return what + " " + pixel_format + " " + std::to_string(resolution.width) + "x" + std::to_string(resolution.height);
+}
+
+/**
+ * @brief Device of the stand-in, opened and streaming for as long as the instance lives.
+ */
+class StreamingDevice {
+   public:
+    StreamingDevice(const Resolution& resolution, const std::string& pixel_format)
+        : system_(Arena::OpenSystem()) {
+        camera::DeviceInfo info;
+        info.model  = "TRI028S-C";
+        info.serial = "000000001";
+        device_     = std::make_shared<camera::lucid::Device>(system_, Arena::DeviceInfo(), info);
+
+        camera::DeviceParameters params;
+        params.width        = resolution.width;
+        params.height       = resolution.height;
+        params.pixel_format = pixel_format;
+        device_->config(params);
+        device_->open();
+        device_->stream();
+    }
+
+    ~StreamingDevice() {
+        device_->stop();
+        device_->release();
+        device_.reset();
+        Arena::CloseSystem(system_);
+    }
+
+    StreamingDevice(const StreamingDevice&)            = delete;
+    StreamingDevice& operator=(const StreamingDevice&) = delete;
+
+    camera::lucid::Device* operator->() { return device_.get(); }
+
+   private:
+    Arena::ISystem*                        system_ = nullptr;
+    std::shared_ptr<camera::lucid::Device> device_ = nullptr;
+};
+}  // namespace
+
+TEST_CASE("capture", "[benchmark][capture]") {
+    for (const std::string pixel_format : {"BayerRG8", "RGB8"}) {
+        for (const auto& resolution : kResolutions) {
+            StreamingDevice device(resolution, pixel_format);
+
+            const auto probe = device->capture();
+            REQUIRE(probe->rows == static_cast<std::size_t>(resolution.height));
+            REQUIRE(probe->cols == static_cast<std::size_t>(resolution.width));
+            const auto size = probe->step * probe->rows;
+
+            BENCHMARK(nameOf("capture", pixel_format, resolution)) {
+                return device->capture();
+            };
+
+            std::vector<uint8_t> source(size, 0x5A);
+            std::vector<uint8_t> target(size);
+            BENCHMARK(nameOf("memcpy", pixel_format, resolution)) {
+                std::memcpy(target.data(), source.data(), size);
+                return target[size / 2];
+            };
+
+            CHECK(device->stats().underruns == 0);
+        }
+    }
+}
+
+TEST_CASE("allocation", "[benchmark][allocation]") {
+    const std::string pixel_format = "BayerRG8";
+    for (const auto& resolution : kResolutions) {
+        const auto size = static_cast<std::size_t>(resolution.width * resolution.height);
+
+        // the pool hands the buffer of the previous run back, whereas new touches fresh pages on every run
+        const auto pool = std::make_shared<camera::BufferPool>();
+        BENCHMARK(nameOf("pool acquire", pixel_format, resolution)) {
+            auto buffer = pool->acquire(size);
+            std::memset(buffer.get(), 0, size);
+            return buffer;
+        };
+        BENCHMARK(nameOf("new", pixel_format, resolution)) {
+            camera::Buffer buffer(new uint8_t[size]);
+            std::memset(buffer.get(), 0, size);
+            return buffer;
+        };
+        CHECK(pool->cachedBytes() >= size);  // rounded up to its size class
+    }
+
+    // frames held by the application, like by a queue of consumers, keep their buffers out of the pool until released
+    StreamingDevice device(kResolutions.back(), pixel_format);
+    for (const std::size_t in_flight : {1UL, 4UL}) {
+        BENCHMARK_ADVANCED(nameOf("capture, " + std::to_string(in_flight) + " in flight,", pixel_format,
+                                  kResolutions.back()))
+        (Catch::Benchmark::Chronometer meter) {
+            std::deque<std::shared_ptr<camera::IImage>> held;
+            meter.measure([&] {
+                held.push_back(device->capture());
+                if (held.size() > in_flight) {
+                    held.pop_front();
+                }
+            });
+        };
+    }
+}
@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+
+/**
+ * @details
+ * compares every capture benchmark with the memcpy of the same size, measured in the same run, from the results the
+ * xml reporter of Catch2 writes. the copy is most of the cost of a capture, so that the ratio of their means stays
+ * close to 1 on any machine, and grows when the host side of a capture regresses.
+ *
+ * usage: compare <results.xml> <max ratio>
+ */
+
+namespace {
+const std::string kCapture = "capture ";
+const std::string kMemcpy  = "memcpy ";
+
+/**
+ * @brief Reads the means of the benchmarks of a run.
+ *
+ * @param results [in] output of the xml reporter.
+ * @return mean of every benchmark in nanoseconds, by name.
+ */
+std::map<std::string, double> meansOf(const std::string& results) {
+    static const std::string kName = "<BenchmarkResults name=\"";
+    static const std::string kMean = "<mean value=\"";
+
+    std::map<std::string, double> means;
+    for (auto name = results.find(kName); name != std::string::npos; name = results.find(kName, name)) {
+        name += kName.size();
+        auto mean = results.find(kMean, name);
+        if (mean == std::string::npos) {
+            break;
+        }
+        mean += kMean.size();
+        means[results.substr(name, results.find('"', name) - name)] =
+            std::stod(results.substr(mean, results.find('"', mean) - mean));
+    }
+    return means;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <results.xml> <max ratio>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::cerr << "failed to open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string results((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const double      max_ratio = std::stod(argv[2]);
+
+    const auto means    = meansOf(results);
+    int        compared = 0;
+    int        failed   = 0;
+    for (const auto& [name, mean] : means) {
+        if (name.compare(0, kCapture.size(), kCapture) != 0) {
+            continue;
+        }
+
+        const auto what     = name.substr(kCapture.size());
+        const auto baseline = means.find(kMemcpy + what);
+        if (baseline == means.end() || baseline->second <= 0) {
+            std::cerr << "no memcpy baseline for " << name << std::endl;
+            ++failed;
+            continue;
+        }
+
+        const auto ratio = mean / baseline->second;
+        const bool ok    = ratio <= max_ratio;
+        std::ostringstream line;
+        line << (ok ? "ok   " : "FAIL ") << what << ": capture " << mean << " ns, memcpy " << baseline->second
+             << " ns, ratio " << ratio << " (max " << max_ratio << ")";
+        (ok ? std::cout : std::cerr) << line.str() << std::endl;
+
+        ++compared;
+        failed += ok ? 0 : 1;
+    }
+
+    if (compared == 0 && failed == 0) {
+        std::cerr << "no capture benchmarks in " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
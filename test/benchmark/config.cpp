@@ -0,0 +1,72 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+#include "camera/api/lucid.h"
+
+/**
+ * @details
+ * measures `camera::lucid::Config` against the in-process stand-in of the Arena SDK, whose nodes live in memory, so
+ * that the numbers hold the cost of the host side of an access: finding the node map holding the node, converting the
+ * value and handling the result. nodes are looked up in the maps of the device, the stream, the system and the
+ * transport layer of the device, in that order, and one node of each is measured.
+ */
+
+TEST_CASE("config", "[benchmark][config]") {
+    Arena::ISystem* const system = Arena::OpenSystem();
+    Arena::IDevice* const device = system->CreateDevice(Arena::DeviceInfo());
+    camera::lucid::Config config(system, device);
+
+    BENCHMARK("get integer of the device") {
+        return config.getWidth();
+    };
+    BENCHMARK("get integer of the stream") {
+        return config.getStreamLostFrameCount();
+    };
+    BENCHMARK("get string of the transport layer") {
+        return config.getDeviceAccessStatus();
+    };
+    BENCHMARK("get enumeration") {
+        return config.getPixelFormat();
+    };
+
+    BENCHMARK("set float") {
+        config.setExposureTime(1000.0);
+    };
+    BENCHMARK("set enumeration by value") {
+        config.setTriggerMode(camera::Switch::OFF);
+    };
+    CHECK(config.getTriggerMode() == "Off");
+    BENCHMARK("set enumeration by name") {
+        config.setPixelFormat("BayerRG8");
+    };
+    CHECK(config.getPixelFormat() == "BayerRG8");
+
+    BENCHMARK("set unknown enumeration entry") {
+        try {
+            config.setTriggerSource("Unknown");
+        } catch (const camera::exception::InvalidConfigValue& e) {}
+    };
+
+    system->DestroyDevice(device);
+    Arena::CloseSystem(system);
+}
+
+TEST_CASE("open", "[benchmark][config]") {
+    Arena::ISystem* const system = Arena::OpenSystem();
+
+    camera::DeviceInfo info;
+    info.model = "TRI028S-C";
+    auto device = std::make_shared<camera::lucid::Device>(system, Arena::DeviceInfo(), info);
+    device->config(camera::DeviceParameters());
+
+    // every parameter is applied to the device on open, which the stand-in creates anew every time
+    BENCHMARK("open and release") {
+        device->open();
+        device->release();
+    };
+
+    device.reset();
+    Arena::CloseSystem(system);
+}
@@ -0,0 +1,58 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "camera/api/lucid.h"
+
+/**
+ * @details
+ * measures the pixel conversion of `camera::Pyramid` over full frames of the sensor, in every format it supports.
+ * BayerRG8 frames are demosaiced into the RGB8 levels, the other formats are only downscaled.
+ */
+
+namespace {
+constexpr std::size_t kRows = 1464;
+constexpr std::size_t kCols = 1936;
+
+camera::IImage frameOf(const camera::PixelFormat format, const std::size_t channels,
+                       const std::shared_ptr<camera::BufferPool>& pool) {
+    camera::IImage image;
+    image.complete = true;
+    image.rows     = kRows;
+    image.cols     = kCols;
+    image.step     = kCols * channels;
+    image.depth    = 8 * channels;
+    image.format   = format;
+    image.data     = pool->acquire(image.step * image.rows);
+    for (std::size_t i = 0; i < image.step * image.rows; i++) {
+        image.data[i] = static_cast<uint8_t>(i * 7);
+    }
+    return image;
+}
+}  // namespace
+
+TEST_CASE("pyramid", "[benchmark][conversion]") {
+    const std::vector<std::pair<std::string, std::pair<camera::PixelFormat, std::size_t>>> formats = {
+        {"Mono8", {camera::PixelFormat::MONO8, 1}},
+        {"BayerRG8", {camera::PixelFormat::BAYER_RG8, 1}},
+        {"RGB8", {camera::PixelFormat::RGB8, 3}},
+    };
+
+    const auto pool = std::make_shared<camera::BufferPool>();
+    for (const auto& [name, format] : formats) {
+        auto image = frameOf(format.first, format.second, pool);
+
+        for (const std::size_t num_levels : {1UL, 3UL}) {
+            camera::Pyramid pyramid(num_levels, pool);
+            BENCHMARK("pyramid " + name + " " + std::to_string(num_levels) + " levels") {
+                pyramid.process(image);
+                return image.levels.size();
+            };
+            REQUIRE(image.levels.size() == num_levels);
+        }
+    }
+}
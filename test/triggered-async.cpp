@@ -55,17 +55,17 @@ TEST_CASE("triggered-async", "camera/lucid") {
          * to enable the action trigger-mode, acquisition frame rate
          * must be set to 0.
          */
-        params.action_unconditional_mode         = "On";
+        params.action_unconditional_mode         = camera::Switch::ON;
         params.acquisition_frame_rate            = 0.0;
-        params.acquisition_mode                  = "Continuous";
-        params.acquisition_start_mode            = "Normal";
+        params.acquisition_mode                  = camera::AcquisitionMode::CONTINUOUS;
+        params.acquisition_start_mode            = camera::AcquisitionStartMode::NORMAL;
         params.binning_horizontal                = 1;
-        params.binning_horizontal_mode           = "Average";
-        params.binning_selector                  = "Digital";
+        params.binning_horizontal_mode           = camera::BinningMode::AVERAGE;
+        params.binning_selector                  = camera::BinningSelector::DIGITAL;
         params.binning_vertical                  = 1;
-        params.binning_vertical_mode             = "Average";
-        params.exposure_auto                     = "Continuous";
-        params.exposure_auto_limit_auto          = "Off";
+        params.binning_vertical_mode             = camera::BinningMode::AVERAGE;
+        params.exposure_auto                     = camera::AutoMode::CONTINUOUS;
+        params.exposure_auto_limit_auto          = camera::AutoMode::OFF;
         params.exposure_auto_lower_limit         = 30.0;
         params.exposure_auto_upper_limit         = 2500.0;
         params.exposure_time                     = 500.0;
@@ -75,23 +75,23 @@ TEST_CASE("triggered-async", "camera/lucid") {
         params.reverse_x                         = false;
         params.reverse_y                         = false;
         params.stream_auto_negotiate_packet_size = false;
-        params.stream_buffer_handling_mode       = "NewestOnly";
+        params.stream_buffer_handling_mode       = camera::StreamBufferHandlingMode::NEWEST_ONLY;
         params.stream_multicast_enable           = false;
         params.stream_packet_resend_enable       = true;
         params.target_brightness                 = 90;
-        params.transfer_control_mode             = "UserControlled";
-        params.transfer_operation_mode           = "Continuous";
+        params.transfer_control_mode             = camera::TransferControlMode::USER_CONTROLLED;
+        params.transfer_operation_mode           = camera::TransferOperationMode::CONTINUOUS;
 
         /**
          * @note for the case of lucid-vision-labs products,
          * to enable the action trigger-mode, the parameters below
          * must be configured.
          */
-        params.trigger_activation = "RisingEdge";
-        params.trigger_latency    = "Off";
-        params.trigger_mode       = "On";
-        params.trigger_overlap    = "PreviousFrame";
-        params.trigger_selector   = "FrameStart";
+        params.trigger_activation = camera::TriggerActivation::RISING_EDGE;
+        params.trigger_latency    = camera::TriggerLatency::OFF;
+        params.trigger_mode       = camera::Switch::ON;
+        params.trigger_overlap    = camera::TriggerOverlap::PREVIOUS_FRAME;
+        params.trigger_selector   = camera::TriggerSelector::FRAME_START;
         params.trigger_source     = "Action0";
         params.trigger_delay      = static_cast<double>(i * 100000.0 / devices.size());
 
@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "camera/assembler.h"
+#include "camera/exception.h"
+
+/**
+ * @details
+ * it tests `camera::FrameSetAssembler`: matching the frames of several devices by their stamps and by the action
+ * command they were triggered by, keeping the spread of the stamps in a set within the tolerance, delivering partial
+ * sets once their deadline has passed or a later set completed, and discarding frames of sets which have been
+ * delivered already.
+ */
+
+namespace {
+std::shared_ptr<const camera::IImage> frameAt(const uint64_t stamp) {
+    auto image          = std::make_shared<camera::IImage>();
+    image->header.stamp = stamp;
+    return image;
+}
+
+/**
+ * @brief Collects the sets delivered by the worker of an assembler.
+ */
+class Collector {
+   public:
+    camera::FrameSetAssembler::Callback callback() {
+        return [this](camera::FrameSetAssembler::FrameSet&& set) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sets_.emplace_back(std::move(set));
+            cv_.notify_all();
+        };
+    }
+
+    /**
+     * @return the sets delivered so far, once there are at least `count` of them or a second has passed.
+     */
+    std::vector<camera::FrameSetAssembler::FrameSet> waitFor(const std::size_t count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::seconds(1), [&]() { return sets_.size() >= count; });
+        return sets_;
+    }
+
+   private:
+    std::mutex                                       mutex_;
+    std::condition_variable                          cv_;
+    std::vector<camera::FrameSetAssembler::FrameSet> sets_;
+};
+}  // namespace
+
+TEST_CASE("assembler options", "[unit][assembler]") {
+    camera::FrameSetAssembler::Options options;
+    CHECK_THROWS_AS(camera::FrameSetAssembler(options, nullptr), camera::exception::InvalidConfigValue);
+
+    options.num_devices = 2;
+    options.mode        = camera::FrameSetAssembler::Mode::ACTION_EPOCH;
+    CHECK_THROWS_AS(camera::FrameSetAssembler(options, nullptr), camera::exception::InvalidConfigValue);
+
+    options.mode       = camera::FrameSetAssembler::Mode::TIMESTAMP;
+    options.offsets_ns = {0};
+    CHECK_THROWS_AS(camera::FrameSetAssembler(options, nullptr), camera::exception::InvalidConfigValue);
+}
+
+TEST_CASE("assembler by timestamp", "[unit][assembler]") {
+    camera::FrameSetAssembler::Options options;
+    options.num_devices  = 2;
+    options.tolerance_ns = 1'000;
+    options.offsets_ns   = {0, 500};
+    options.deadline_ns  = 10'000'000'000;  // sets are only closed by later ones
+
+    Collector collector;
+    {
+        camera::FrameSetAssembler assembler(options, collector.callback());
+        REQUIRE(assembler.push(0, frameAt(10'000)));
+        REQUIRE(assembler.push(1, frameAt(11'200)));  // 10'700 once offset
+        REQUIRE(collector.waitFor(1).size() == 1);
+
+        // the frame of the second device is missing, until a complete set closes it
+        REQUIRE(assembler.push(0, frameAt(20'000)));
+        REQUIRE(assembler.push(0, frameAt(30'000)));
+        REQUIRE(assembler.push(1, frameAt(30'400)));
+        REQUIRE(collector.waitFor(3).size() == 3);
+
+        // it belongs to a set which has been delivered
+        REQUIRE(assembler.push(1, frameAt(20'600)));
+        REQUIRE(assembler.push(0, frameAt(40'000)));
+        REQUIRE(assembler.push(1, frameAt(40'000)));
+        REQUIRE(collector.waitFor(4).size() == 4);
+
+        const auto stats = assembler.stats();
+        CHECK(stats.complete == 3);
+        CHECK(stats.partial == 1);
+        CHECK(stats.late == 1);
+    }
+
+    const auto sets = collector.waitFor(4);
+    REQUIRE(sets.size() == 4);
+    REQUIRE(sets[0].complete());
+    CHECK(sets[0].key == 10'000);
+    CHECK(sets[0].frames[0]->header.stamp == 10'000);
+    CHECK(sets[0].frames[1]->header.stamp == 11'200);
+    REQUIRE_FALSE(sets[1].complete());
+    CHECK(sets[1].key == 20'000);
+    CHECK(sets[1].frames[1] == nullptr);
+    REQUIRE(sets[2].complete());
+    CHECK(sets[2].frames[0]->header.stamp == 30'000);
+    CHECK(sets[2].frames[1]->header.stamp == 30'400);
+    CHECK(sets[3].complete());
+}
+
+TEST_CASE("assembler spread", "[unit][assembler]") {
+    camera::FrameSetAssembler::Options options;
+    options.num_devices  = 3;
+    options.tolerance_ns = 1'000;
+    options.deadline_ns  = 10'000'000'000;
+
+    Collector collector;
+    {
+        // every pair of these stamps is within the tolerance of the one in the middle, but not all three together
+        camera::FrameSetAssembler assembler(options, collector.callback());
+        REQUIRE(assembler.push(0, frameAt(10'900)));
+        REQUIRE(assembler.push(1, frameAt(10'000)));
+        REQUIRE(assembler.push(2, frameAt(11'800)));
+    }
+
+    const auto sets = collector.waitFor(2);
+    REQUIRE(sets.size() == 2);
+    for (const auto& set : sets) {
+        CHECK_FALSE(set.complete());
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        for (const auto& frame : set.frames) {
+            if (frame != nullptr) {
+                min = std::min<uint64_t>(min, frame->header.stamp);
+                max = std::max<uint64_t>(max, frame->header.stamp);
+            }
+        }
+        CHECK(set.key == min);
+        CHECK(max - min <= options.tolerance_ns);
+    }
+}
+
+TEST_CASE("assembler by action epoch", "[unit][assembler]") {
+    camera::FrameSetAssembler::Options options;
+    options.num_devices     = 3;
+    options.mode            = camera::FrameSetAssembler::Mode::ACTION_EPOCH;
+    options.epoch_origin_ns = 1'000'000;
+    options.epoch_period_ns = 100'000;
+
+    Collector collector;
+    {
+        camera::FrameSetAssembler assembler(options, collector.callback());
+        // the frames of an action are exposed within half a period of it
+        REQUIRE(assembler.push(0, frameAt(1'200'000)));
+        REQUIRE(assembler.push(1, frameAt(1'249'000)));
+        REQUIRE(assembler.push(2, frameAt(1'151'000)));
+        REQUIRE(collector.waitFor(1).size() == 1);
+    }
+
+    const auto sets = collector.waitFor(1);
+    REQUIRE(sets.size() == 1);
+    CHECK(sets[0].complete());
+    CHECK(sets[0].key == 2);
+}
+
+TEST_CASE("assembler deadline", "[unit][assembler]") {
+    camera::FrameSetAssembler::Options options;
+    options.num_devices    = 2;
+    options.deadline_ns    = 5'000'000;
+    options.queue_capacity = 1;
+
+    Collector                 collector;
+    camera::FrameSetAssembler assembler(options, collector.callback());
+    REQUIRE(assembler.push(1, frameAt(1'000)));
+
+    const auto sets = collector.waitFor(1);
+    REQUIRE(sets.size() == 1);
+    CHECK_FALSE(sets[0].complete());
+    CHECK(sets[0].count == 1);
+    CHECK(sets[0].frames[1] != nullptr);
+    CHECK(assembler.stats().partial == 1);
+
+    CHECK_THROWS_AS(assembler.push(2, frameAt(1'000)), camera::exception::InvalidConfigValue);
+    CHECK_FALSE(assembler.push(0, nullptr));
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "camera/gap.h"
+
+/**
+ * @details
+ * it tests `camera::GapTracker`: skipped sequence numbers, restarts of the stream, incomplete frames, and the loss
+ * counters of the stream, which are only read when a frame reveals a loss and only count their growth.
+ */
+
+namespace {
+camera::IImage frameOf(const uint64_t seq, const bool complete = true) {
+    camera::IImage image;
+    image.header.seq   = seq;
+    image.header.stamp = seq * 1'000;
+    image.complete     = complete;
+    return image;
+}
+}  // namespace
+
+TEST_CASE("gap sequence", "[unit][gap]") {
+    std::vector<camera::GapTracker::Event> events;
+    camera::GapTracker                     tracker;
+    tracker.setCallback([&events](const camera::GapTracker::Event& event) { events.push_back(event); });
+
+    CHECK_FALSE(tracker.observe(frameOf(1)));
+    CHECK_FALSE(tracker.observe(frameOf(2)));
+    CHECK(tracker.observe(frameOf(5)));
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].kind == camera::GapTracker::Event::Kind::SKIPPED);
+    CHECK(events[0].seq == 5);
+    CHECK(events[0].stamp == 5'000);
+    CHECK(events[0].count == 2);
+
+    // a number going backwards restarts the sequence rather than revealing a gap
+    CHECK_FALSE(tracker.observe(frameOf(3)));
+    CHECK_FALSE(tracker.observe(frameOf(4)));
+    CHECK(events.size() == 1);
+
+    // so does a restart of the stream, whichever number it starts at
+    tracker.restart();
+    CHECK_FALSE(tracker.observe(frameOf(100)));
+
+    CHECK(tracker.observe(frameOf(101, false)));
+    REQUIRE(events.size() == 2);
+    CHECK(events[1].kind == camera::GapTracker::Event::Kind::INCOMPLETE);
+    CHECK(events[1].count == 1);
+
+    const auto stats = tracker.stats();
+    CHECK(stats.frames == 7);
+    CHECK(stats.gaps == 1);
+    CHECK(stats.skipped == 2);
+    CHECK(stats.restarts == 1);
+    CHECK(stats.incomplete == 1);
+}
+
+TEST_CASE("gap stream counters", "[unit][gap]") {
+    std::vector<camera::GapTracker::Event> events;
+    int64_t                                lost_frames    = 0;
+    int64_t                                missed_packets = 0;
+    int                                    reads          = 0;
+
+    camera::GapTracker tracker;
+    tracker.setCallback([&events](const camera::GapTracker::Event& event) { events.push_back(event); });
+    tracker.setStreamCounters([&](int64_t& frames, int64_t& packets) {
+        reads++;
+        frames  = lost_frames;
+        packets = missed_packets;
+        return true;
+    });
+
+    // the counters are not read without a loss
+    tracker.observe(frameOf(1));
+    tracker.observe(frameOf(2));
+    CHECK(reads == 0);
+
+    lost_frames    = 2;
+    missed_packets = 30;
+    tracker.observe(frameOf(5));
+    CHECK(reads == 1);
+    REQUIRE(events.size() == 3);
+    CHECK(events[1].kind == camera::GapTracker::Event::Kind::LOST_FRAMES);
+    CHECK(events[1].count == 2);
+    CHECK(events[2].kind == camera::GapTracker::Event::Kind::MISSED_PACKETS);
+    CHECK(events[2].count == 30);
+
+    // only the growth since the previous read is new
+    lost_frames = 3;
+    tracker.observe(frameOf(6, false));
+    REQUIRE(events.size() == 5);
+    CHECK(events[4].kind == camera::GapTracker::Event::Kind::LOST_FRAMES);
+    CHECK(events[4].count == 1);
+
+    // the counters of a new stream start from 0 again
+    tracker.restart();
+    lost_frames    = 1;
+    missed_packets = 0;
+    tracker.observe(frameOf(1, false));
+    REQUIRE(events.size() == 7);
+    CHECK(events[6].kind == camera::GapTracker::Event::Kind::LOST_FRAMES);
+    CHECK(events[6].count == 1);
+
+    // a lost link is reported with the last frame before it
+    tracker.disconnected();
+    REQUIRE(events.size() == 8);
+    CHECK(events[7].kind == camera::GapTracker::Event::Kind::DISCONNECTED);
+    CHECK(events[7].seq == 1);
+    CHECK(events[7].stamp == 1'000);
+
+    tracker.reconnected(frameOf(2), 15);
+    REQUIRE(events.size() == 9);
+    CHECK(events[8].kind == camera::GapTracker::Event::Kind::RECONNECTED);
+    CHECK(events[8].count == 15);
+
+    const auto stats = tracker.stats();
+    CHECK(stats.lost_frames == 4);
+    CHECK(stats.missed_packets == 30);
+    CHECK(stats.disconnects == 1);
+    CHECK(stats.reconnects == 1);
+}
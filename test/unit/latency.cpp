@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "camera/latency.h"
+
+/**
+ * @details
+ * it tests the bucket math of `camera::LatencyHistogram`, whose percentiles are exact below 128 ns and within half a
+ * sub-bucket, 1/128 of the value, above, and the stages recorded by `camera::FrameLatency`.
+ */
+
+TEST_CASE("histogram percentiles", "[unit][latency]") {
+    camera::LatencyHistogram histogram;
+    CHECK(histogram.percentile(50.0) == 0);
+
+    for (int64_t ns = 1; ns <= 100; ns++) {
+        histogram.record(ns);
+    }
+    CHECK(histogram.percentile(1.0) == 1);
+    CHECK(histogram.percentile(50.0) == 50);
+    CHECK(histogram.percentile(99.0) == 99);
+    CHECK(histogram.percentile(100.0) == 100);
+
+    const auto summary = histogram.summary();
+    CHECK(summary.count == 100);
+    CHECK(summary.p50_ns == 50);
+    CHECK(summary.max_ns == 100);
+
+    histogram.reset();
+    CHECK(histogram.summary().count == 0);
+    CHECK(histogram.percentile(99.0) == 0);
+
+    histogram.record(-5);  // clocks slightly out of sync
+    CHECK(histogram.percentile(100.0) == 0);
+}
+
+TEST_CASE("histogram error", "[unit][latency]") {
+    for (uint64_t ns = 64; ns < (uint64_t{1} << 40); ns = ns * 3 / 2 + 7) {
+        camera::LatencyHistogram histogram;
+        histogram.record(static_cast<int64_t>(ns));
+        histogram.record(int64_t{1} << 41);  // keeps the percentile from being clamped to the max
+
+        const auto value = static_cast<uint64_t>(histogram.percentile(50.0));
+        const auto error = (value > ns) ? value - ns : ns - value;
+        INFO("ns = " << ns << ", percentile = " << value);
+        REQUIRE(error <= ns / 128);
+    }
+}
+
+TEST_CASE("histogram overflow", "[unit][latency]") {
+    camera::LatencyHistogram histogram;
+    histogram.record(int64_t{1} << 50);
+
+    // values past the range fall into the last bucket, whose value is clamped to the max
+    CHECK(histogram.percentile(100.0) < (int64_t{1} << 40));
+    CHECK(histogram.percentile(100.0) > (int64_t{1} << 39));
+    CHECK(histogram.summary().max_ns == (int64_t{1} << 50));
+}
+
+TEST_CASE("frame latency stages", "[unit][latency]") {
+    camera::FrameLatency latency;
+
+    camera::IImage image;
+    image.header.stamp         = 1'000;
+    image.header.dequeue_stamp = 50'000;
+
+    // the time since the exposure is only recorded with a device clock
+    latency.captured(image, 53'000);
+    CHECK(latency.histogram(camera::FrameLatency::DEQUEUE).summary().count == 0);
+    CHECK(latency.histogram(camera::FrameLatency::CAPTURE).summary().max_ns == 3'000);
+
+    latency.setDeviceClock([](const uint64_t stamp) { return stamp + 40'000; });
+    latency.captured(image, 53'000);
+    CHECK(latency.histogram(camera::FrameLatency::DEQUEUE).summary().max_ns == 9'000);
+
+    const auto stage = latency.addStage("encode");
+    latency.record(stage, image, 60'000);
+    CHECK(latency.histogram(stage).summary().max_ns == 10'000);
+
+    const auto reports = latency.report();
+    REQUIRE(reports.size() == 3);
+    CHECK(reports[0].name == "dequeue");
+    CHECK(reports[1].name == "capture");
+    CHECK(reports[2].name == "encode");
+    CHECK(reports[1].summary.count == 2);
+
+    while (latency.report().size() < camera::FrameLatency::kMaxStages) {
+        latency.addStage("stage");
+    }
+    CHECK_THROWS_AS(latency.addStage("too many"), std::length_error);
+
+    latency.reset();
+    CHECK(latency.report().size() == camera::FrameLatency::kMaxStages);
+    CHECK(latency.histogram(stage).summary().count == 0);
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "camera/exception.h"
+#include "camera/lucid/network.hpp"
+
+/**
+ * @details
+ * it tests `camera::lucid::network::planAddresses()`: devices keep valid addresses of the subnet, the others are
+ * assigned free ones derived from their MACs, probing past collisions and reserved addresses, and a subnet too small
+ * for the devices is rejected. it also tests `camera::lucid::network::planSubnets()`, which plans interfaces sharing
+ * a subnet without handing out the addresses devices of other interfaces keep.
+ */
+
+namespace {
+using camera::lucid::network::Assignment;
+using camera::lucid::network::planAddresses;
+using camera::lucid::network::planSubnets;
+using camera::lucid::network::Subnet;
+
+constexpr uint32_t kHost = 0xC0A80001;  // 192.168.0.1
+constexpr uint32_t kMask = 0xFFFFFFF8;  // /29, host parts 1 to 6
+
+Assignment offSubnet(const uint64_t mac) {
+    return Assignment{mac, 0xA9FE0000 | static_cast<uint32_t>(mac & 0xFFFF), 0xFFFF0000, false};
+}
+
+/**
+ * @brief Checks that every address is a distinct usable address of the subnet of the host, other than the host's.
+ */
+void checkUsable(const std::vector<Assignment>& plan, const std::set<uint32_t>& reserved = {}) {
+    std::set<uint32_t> addresses;
+    for (const auto& device : plan) {
+        const auto host_part = device.ip_address & ~kMask;
+        CHECK((device.ip_address & kMask) == (kHost & kMask));
+        CHECK(device.subnet_mask == kMask);
+        CHECK(host_part != 0);
+        CHECK(host_part != ~kMask);
+        CHECK(device.ip_address != kHost);
+        CHECK(reserved.count(device.ip_address) == 0);
+        CHECK(addresses.insert(device.ip_address).second);
+    }
+}
+}  // namespace
+
+TEST_CASE("plan keeps valid addresses", "[unit][network]") {
+    const std::vector<Assignment> devices = {
+        {1, kHost + 2, kMask, false},
+        {2, kHost + 2, kMask, false},      // collides with the first device
+        {3, kHost, kMask, false},          // collides with the host
+        {4, kHost + 5, 0xFFFFFF00, false}, // on the subnet with another mask
+    };
+    const auto plan = planAddresses(kHost, kMask, devices);
+    REQUIRE(plan.size() == devices.size());
+    checkUsable(plan);
+
+    // the device with the lower MAC keeps the address both claim
+    CHECK_FALSE(plan[0].forced);
+    CHECK(plan[0].ip_address == kHost + 2);
+    CHECK(plan[1].forced);
+    CHECK(plan[2].forced);
+    CHECK(plan[3].forced);
+}
+
+TEST_CASE("plan fills the subnet past collisions", "[unit][network]") {
+    // five devices on the five free addresses of the subnet, so probing has to resolve every collision of the hash
+    std::vector<Assignment> devices;
+    for (uint64_t mac = 0x1C0FAF000001; devices.size() < 5; mac += 0x10001) {
+        devices.push_back(offSubnet(mac));
+    }
+    const auto plan = planAddresses(kHost, kMask, devices);
+    REQUIRE(plan.size() == devices.size());
+    checkUsable(plan);
+    CHECK(std::all_of(plan.begin(), plan.end(), [](const Assignment& device) { return device.forced; }));
+
+    // the same devices are assigned the same addresses whatever their order
+    auto reversed = devices;
+    std::reverse(reversed.begin(), reversed.end());
+    std::map<uint64_t, uint32_t> addresses;
+    for (const auto& device : plan) {
+        addresses[device.mac] = device.ip_address;
+    }
+    for (const auto& device : planAddresses(kHost, kMask, reversed)) {
+        CHECK(addresses[device.mac] == device.ip_address);
+    }
+
+    // one device more does not fit
+    devices.push_back(offSubnet(0x1C0FAF0000FF));
+    CHECK_THROWS_AS(planAddresses(kHost, kMask, devices), camera::exception::InvalidConfigValue);
+}
+
+TEST_CASE("plan avoids reserved addresses", "[unit][network]") {
+    const std::vector<uint32_t> reserved = {kHost + 1, kHost + 3, 0x0A000001};  // the last one is of another subnet
+    const std::vector<Assignment> devices = {offSubnet(0xA1), offSubnet(0xB2), {0xC3, kHost + 1, kMask, false}};
+
+    const auto plan = planAddresses(kHost, kMask, devices, reserved);
+    checkUsable(plan, {kHost + 1, kHost + 3});
+    CHECK(plan[2].forced);  // taken by a device of another interface
+
+    // the host, two reserved addresses and four devices exceed the six usable addresses
+    auto more = devices;
+    more.push_back(offSubnet(0xD4));
+    CHECK_THROWS_AS(planAddresses(kHost, kMask, more, reserved), camera::exception::InvalidConfigValue);
+
+    // a subnet without room for a single device besides the host
+    CHECK_THROWS_AS(planAddresses(kHost, 0xFFFFFFFE, {offSubnet(0xA1)}), camera::exception::InvalidConfigValue);
+}
+
+TEST_CASE("plan interfaces sharing a subnet", "[unit][network]") {
+    // the second interface keeps the address of its device, which the first would otherwise hand to one of its own
+    const Subnet first{kHost, kMask, {offSubnet(0xA1), offSubnet(0xB2), offSubnet(0xC3)}};
+    const Subnet second{kHost + 5, kMask, {{0xD4, kHost + 2, kMask, false}}};
+
+    const auto plan = planSubnets({first, second});
+    REQUIRE(plan.size() == 4);
+    checkUsable(plan, {kHost + 5});
+    CHECK(plan[3].ip_address == kHost + 2);
+    CHECK_FALSE(plan[3].forced);
+
+    // the first interface keeps nothing, since its device collides with the one kept by the second
+    const Subnet colliding{kHost, kMask, {{0xE5, kHost + 2, kMask, false}}};
+    const auto   collided = planSubnets({colliding, second});
+    REQUIRE(collided.size() == 2);
+    CHECK(collided[0].forced);
+    CHECK_FALSE(collided[1].forced);
+    CHECK(collided[0].ip_address != collided[1].ip_address);
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "camera/exception.h"
+#include "camera/profile.h"
+
+/**
+ * @details
+ * it tests that `camera::profile` reads back every kind of parameter it writes, that the hash follows the parameters,
+ * and that invalid profiles are rejected.
+ */
+
+namespace {
+camera::DeviceParameters changedParameters() {
+    camera::DeviceParameters param;
+    param.action_device_key      = 0x12345678;
+    param.acquisition_frame_rate = 12.345678901234567;
+    param.acquisition_mode       = camera::AcquisitionMode::MULTI_FRAME;
+    param.chunk_enable           = {"Timestamp", "Gain"};
+    param.chunk_mode_active      = true;
+    param.exposure_auto          = camera::AutoMode::OFF;
+    param.exposure_time          = 0.1;
+    param.gev_scda               = "239.1.2.3";
+    param.pixel_format           = "RGB8";
+    param.ptp_enable             = false;
+    param.trigger_mode           = camera::Switch::ON;
+    param.trigger_selector       = camera::TriggerSelector::FRAME_START;
+    param.width                  = 1280;
+    return param;
+}
+}  // namespace
+
+TEST_CASE("profile round trip", "[unit][profile]") {
+    const auto param = changedParameters();
+    const auto text  = camera::profile::serialize(param);
+
+    const auto parsed = camera::profile::parse(text);
+    CHECK(camera::profile::serialize(parsed) == text);
+    CHECK(parsed.action_device_key == param.action_device_key);
+    CHECK(parsed.acquisition_frame_rate == param.acquisition_frame_rate);  // read back exactly
+    CHECK(parsed.acquisition_mode == param.acquisition_mode);
+    CHECK(parsed.chunk_enable == param.chunk_enable);
+    CHECK(parsed.exposure_time == param.exposure_time);
+    CHECK(parsed.gev_scda == param.gev_scda);
+    CHECK(parsed.ptp_enable == param.ptp_enable);
+    CHECK(parsed.trigger_mode == param.trigger_mode);
+
+    // an empty value, a comment and missing parameters, which keep their default
+    const auto defaults = camera::profile::parse("# comment\nprofile_user_set=\nwidth=640\n");
+    CHECK(defaults.profile_user_set.empty());
+    CHECK(defaults.width == 640);
+    CHECK(defaults.pixel_format == camera::DeviceParameters().pixel_format);
+}
+
+TEST_CASE("profile hash", "[unit][profile]") {
+    const auto param = changedParameters();
+    CHECK(camera::profile::hashOf(param) == camera::profile::hashOf(changedParameters()));
+    CHECK(camera::profile::hashOf(param) != camera::profile::hashOf(camera::DeviceParameters()));
+
+    auto other = param;
+    other.exposure_time += 1e-9;
+    CHECK(camera::profile::hashOf(param) != camera::profile::hashOf(other));
+}
+
+TEST_CASE("profile invalid", "[unit][profile]") {
+    CHECK_THROWS_AS(camera::profile::parse("unknown=1\n"), camera::exception::InvalidConfigValue);
+    CHECK_THROWS_AS(camera::profile::parse("width=wide\n"), camera::exception::InvalidConfigValue);
+    CHECK_THROWS_AS(camera::profile::parse("width=1.5\n"), camera::exception::InvalidConfigValue);
+    CHECK_THROWS_AS(camera::profile::parse("ptp_enable=yes\n"), camera::exception::InvalidConfigValue);
+    CHECK_THROWS_AS(camera::profile::parse("trigger_mode=Maybe\n"), camera::exception::InvalidConfigValue);
+    CHECK_THROWS_AS(camera::profile::parse("width\n"), camera::exception::InvalidConfigValue);
+}
+
+TEST_CASE("profile file", "[unit][profile]") {
+    const auto path  = std::filesystem::temp_directory_path() / "camera-unit-profile.txt";
+    const auto param = changedParameters();
+    camera::profile::save(path, param);
+
+    std::ifstream file(path);
+    std::string   head;
+    std::getline(file, head);
+    CHECK(head.size() == 18);  // "# " and the hash in hex
+    CHECK(head.rfind("# ", 0) == 0);
+
+    CHECK(camera::profile::serialize(camera::profile::load(path)) == camera::profile::serialize(param));
+    std::filesystem::remove(path);
+
+    CHECK_THROWS_AS(camera::profile::load(path), camera::exception::GenericException);
+}
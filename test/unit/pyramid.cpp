@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "camera/pyramid.h"
+
+/**
+ * @details
+ * it tests `camera::Pyramid` against the mean of the source pixels each level covers, rounded once, in every format
+ * it supports. the sizes are not multiples of the vector widths, so that the tails of the rows are covered too.
+ */
+
+namespace {
+camera::IImage frameOf(const camera::PixelFormat format, const std::size_t rows, const std::size_t cols,
+                       const std::size_t channels) {
+    std::mt19937   random(42);
+    camera::IImage image;
+    image.rows   = rows;
+    image.cols   = cols;
+    image.step   = cols * channels;
+    image.depth  = 8 * channels;
+    image.format = format;
+    image.data   = camera::Buffer(new uint8_t[image.step * rows]);
+    for (std::size_t i = 0; i < image.step * rows; i++) {
+        image.data[i] = static_cast<uint8_t>(random());
+    }
+    return image;
+}
+
+/**
+ * @brief Gets the mean of a channel over the source pixels a pixel of a level covers, rounded half up.
+ * @param scale [in] Source pixels per level pixel along each axis.
+ */
+int meanOf(const camera::IImage& image, const std::size_t scale, const std::size_t y, const std::size_t x,
+           const std::size_t c) {
+    const bool        is_bayer = (image.format == camera::PixelFormat::BAYER_RG8);
+    const std::size_t channels = image.step / image.cols;
+
+    int sum   = 0;
+    int count = 0;
+    for (std::size_t v = y * scale; v < (y + 1) * scale; v++) {
+        for (std::size_t u = x * scale; u < (x + 1) * scale; u++) {
+            if (is_bayer && (v % 2) + (u % 2) != c) {
+                continue;  // RGGB, whose color counts the odd coordinates
+            }
+            sum += image.data[v * image.step + u * channels + (is_bayer ? 0 : c)];
+            count++;
+        }
+    }
+    return (2 * sum + count) / (2 * count);
+}
+
+void checkLevels(const camera::IImage& image, const std::size_t num_levels) {
+    REQUIRE(image.levels.size() == num_levels);
+    for (std::size_t i = 0; i < num_levels; i++) {
+        const auto& level = *image.levels[i];
+        const auto  scale = std::size_t{2} << i;
+        REQUIRE(level.rows == image.rows / scale);
+        REQUIRE(level.cols == image.cols / scale);
+
+        std::size_t mismatches = 0;
+        for (std::size_t y = 0; y < level.rows; y++) {
+            for (std::size_t x = 0; x < level.cols; x++) {
+                for (std::size_t c = 0; c < level.step / level.cols; c++) {
+                    const auto value = level.data[y * level.step + x * level.step / level.cols + c];
+                    const auto error = std::abs(value - meanOf(image, scale, y, x, c));
+                    REQUIRE(error <= 1);
+                    mismatches += static_cast<std::size_t>(error);
+                }
+            }
+        }
+        INFO("level " << i);
+        if (i < 4) {
+            CHECK(mismatches == 0);  // exact up to 1/16
+        }
+    }
+}
+}  // namespace
+
+TEST_CASE("pyramid mono", "[unit][pyramid]") {
+    auto            image = frameOf(camera::PixelFormat::MONO8, 166, 230, 1);
+    camera::Pyramid pyramid(5);
+    pyramid.process(image);
+    checkLevels(image, 5);
+}
+
+TEST_CASE("pyramid rgb", "[unit][pyramid]") {
+    auto            image = frameOf(camera::PixelFormat::RGB8, 166, 230, 3);
+    camera::Pyramid pyramid(5);
+    pyramid.process(image);
+    checkLevels(image, 5);
+    CHECK(image.levels.front()->format == camera::PixelFormat::RGB8);
+}
+
+TEST_CASE("pyramid bayer", "[unit][pyramid]") {
+    auto            image = frameOf(camera::PixelFormat::BAYER_RG8, 166, 230, 1);
+    camera::Pyramid pyramid(5);
+    pyramid.process(image);
+    checkLevels(image, 5);
+    CHECK(image.levels.front()->format == camera::PixelFormat::RGB8);
+    CHECK(image.levels.front()->step == 3 * image.levels.front()->cols);
+}
+
+TEST_CASE("pyramid small", "[unit][pyramid]") {
+    auto            image = frameOf(camera::PixelFormat::MONO8, 5, 9, 1);
+    camera::Pyramid pyramid(3);
+    pyramid.process(image);
+    checkLevels(image, 2);  // levels stop once they have no pixel
+}
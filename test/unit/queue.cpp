@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <thread>
+
+#include "camera/queue.h"
+
+/**
+ * @details
+ * it tests `camera::SpscQueue`: the capacity rounded up to a power of two, the order of the elements, rejecting
+ * pushes while full, and handing every element over exactly once between a producer and a consumer thread.
+ */
+
+TEST_CASE("queue capacity", "[unit][queue]") {
+    CHECK(camera::SpscQueue<int>(1).capacity() == 1);
+    CHECK(camera::SpscQueue<int>(5).capacity() == 8);
+    CHECK(camera::SpscQueue<int>(16).capacity() == 16);
+}
+
+TEST_CASE("queue order", "[unit][queue]") {
+    camera::SpscQueue<std::unique_ptr<int>> queue(4);
+
+    int value = 0;
+    for (; value < 4; value++) {
+        REQUIRE(queue.push(std::make_unique<int>(value)));
+    }
+    CHECK(queue.size() == 4);
+
+    // a push into the full queue leaves its value untouched
+    auto rejected = std::make_unique<int>(value);
+    CHECK_FALSE(queue.push(std::move(rejected)));
+    REQUIRE(rejected != nullptr);
+    CHECK(*rejected == 4);
+
+    std::unique_ptr<int> popped;
+    for (int expected = 0; expected < 4; expected++) {
+        REQUIRE(queue.pop(popped));
+        CHECK(*popped == expected);
+    }
+    CHECK_FALSE(queue.pop(popped));
+    CHECK(queue.size() == 0);
+
+    // the indices wrap around the slots
+    for (int round = 0; round < 10; round++) {
+        REQUIRE(queue.push(std::make_unique<int>(round)));
+        REQUIRE(queue.pop(popped));
+        CHECK(*popped == round);
+    }
+}
+
+TEST_CASE("queue between threads", "[unit][queue]") {
+    constexpr uint64_t          kCount = 200'000;
+    camera::SpscQueue<uint64_t> queue(64);
+
+    std::thread producer([&queue]() {
+        for (uint64_t value = 0; value < kCount;) {
+            auto copy = value;
+            if (queue.push(std::move(copy))) {
+                value++;
+            }
+        }
+    });
+
+    uint64_t expected  = 0;
+    bool     is_sorted = true;
+    while (expected < kCount) {
+        uint64_t value = 0;
+        if (queue.pop(value)) {
+            is_sorted = is_sorted && (value == expected);
+            expected++;
+        }
+    }
+    producer.join();
+
+    CHECK(is_sorted);
+    CHECK(queue.size() == 0);
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "camera/stats.h"
+
+/**
+ * @details
+ * it tests `camera::StatsRecorder`: the counters of the captures, and the sampling of the stream counters, which
+ * happens on frames and timeouts alike.
+ */
+
+TEST_CASE("stats counters", "[unit][stats]") {
+    camera::StatsRecorder recorder;
+    recorder.frame(100, true, 10, 1);
+    recorder.frame(100, false, 10, 1);
+    recorder.underrun(50);
+
+    const auto stats = recorder.snapshot();
+    CHECK(stats.frames == 2);
+    CHECK(stats.bytes == 200);
+    CHECK(stats.incomplete == 1);
+    CHECK(stats.underruns == 1);
+    CHECK(stats.wait_ns == 70);
+    CHECK(stats.copy_ns == 2);
+}
+
+TEST_CASE("stats sampled on underruns", "[unit][stats]") {
+    int                   samples = 0;
+    camera::StatsRecorder recorder(0);  // samples on every capture
+    recorder.setStreamSampler([&samples](camera::StatsRecorder::StreamCounters& counters) {
+        counters.lost_frames = ++samples;
+        return true;
+    });
+
+    // a stream which stopped delivering still reports its losses
+    recorder.underrun(1'000);
+    recorder.underrun(1'000);
+    CHECK(samples == 2);
+    CHECK(recorder.snapshot().lost_frames == 2);
+
+    recorder.restart();
+    recorder.underrun(1'000);
+    CHECK(recorder.snapshot().lost_frames == 5);  // 2 of the stream before, and 3 of the current one
+}